@@ -0,0 +1,190 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_INDEXED_MIN_HEAP_H
+#define IGL_INDEXED_MIN_HEAP_H
+#include <vector>
+#include <utility>
+#include <cassert>
+
+namespace igl
+{
+  // Contiguous 4-ary min-heap of (cost, id) pairs with an index from id to
+  // heap slot, so that the cost of any id can be changed in place
+  // (decrease-key / increase-key) without allocating. Drop-in replacement for
+  // the std::set<std::pair<double,int> > + iterator-list pair used by
+  // collapse_edge: pairs are ordered lexicographically, exactly like in the
+  // set, so ties between equal costs are broken by the smaller id and both
+  // queues pop edges in the same order.
+  //
+  // Ids must lie in [0, n) where n is given to resize().
+  class IndexedMinHeap
+  {
+  public:
+    typedef std::pair<double,int> Entry;
+    IndexedMinHeap() {}
+    explicit IndexedMinHeap(const int n) { resize(n); }
+    // Empty the heap and make room for ids 0..n-1
+    inline void resize(const int n)
+    {
+      heap.clear();
+      heap.reserve(n);
+      pos.assign(n, -1);
+    }
+    inline void clear()
+    {
+      for(const auto & h : heap)
+      {
+        pos[h.second] = -1;
+      }
+      heap.clear();
+    }
+    inline bool empty() const { return heap.empty(); }
+    inline int size() const { return (int)heap.size(); }
+    inline bool contains(const int id) const { return pos[id] >= 0; }
+    // Cost currently stored for id (must be contained)
+    inline double cost(const int id) const
+    {
+      assert(contains(id));
+      return heap[pos[id]].first;
+    }
+    // Least (cost, id) pair (heap must not be empty)
+    inline const Entry & top() const
+    {
+      assert(!empty());
+      return heap.front();
+    }
+    // Remove and return the least (cost, id) pair
+    inline Entry pop()
+    {
+      assert(!empty());
+      const Entry t = heap.front();
+      remove_at(0);
+      return t;
+    }
+    // Insert id with a given cost, or change its cost if already present
+    inline void update(const int id, const double cost)
+    {
+      int i = pos[id];
+      if(i < 0)
+      {
+        i = (int)heap.size();
+        heap.emplace_back(cost, id);
+        pos[id] = i;
+        sift_up(i);
+        return;
+      }
+      const Entry old = heap[i];
+      heap[i].first = cost;
+      if(heap[i] < old)
+      {
+        sift_up(i);
+      }else
+      {
+        sift_down(i);
+      }
+    }
+    inline void push(const int id, const double cost) { update(id, cost); }
+    // Replace the contents with ids 0..n-1 and their costs in one O(n)
+    // heapify, instead of n pushes.
+    //
+    // Inputs:
+    //   costs  n list of costs (std::vector or Eigen vector), costs[i] is
+    //     the cost of id i
+    template <typename DerivedCosts>
+    inline void build(const DerivedCosts & costs)
+    {
+      const int n = (int)costs.size();
+      pos.resize(n);
+      heap.resize(n);
+      for(int i = 0; i < n; i++)
+      {
+        heap[i] = Entry(costs[i], i);
+        pos[i] = i;
+      }
+      for(int i = n > 1 ? (n - 2) / ARITY : -1; i >= 0; i--)
+      {
+        sift_down(i);
+      }
+    }
+    // Remove id from the heap (no-op if absent)
+    inline void erase(const int id)
+    {
+      const int i = pos[id];
+      if(i >= 0)
+      {
+        remove_at(i);
+      }
+    }
+  private:
+    static const int ARITY = 4;
+    inline void place(const int i, const Entry & h)
+    {
+      heap[i] = h;
+      pos[h.second] = i;
+    }
+    inline void remove_at(const int i)
+    {
+      pos[heap[i].second] = -1;
+      const Entry last = heap.back();
+      heap.pop_back();
+      if(i < (int)heap.size())
+      {
+        place(i, last);
+        sift_up(i);
+        sift_down(pos[last.second]);
+      }
+    }
+    inline void sift_up(int i)
+    {
+      const Entry h = heap[i];
+      while(i > 0)
+      {
+        const int parent = (i - 1) / ARITY;
+        if(!(h < heap[parent]))
+        {
+          break;
+        }
+        place(i, heap[parent]);
+        i = parent;
+      }
+      place(i, h);
+    }
+    inline void sift_down(int i)
+    {
+      const int n = (int)heap.size();
+      const Entry h = heap[i];
+      while(true)
+      {
+        const int first = ARITY * i + 1;
+        if(first >= n)
+        {
+          break;
+        }
+        const int last = first + ARITY < n ? first + ARITY : n;
+        int best = first;
+        for(int c = first + 1; c < last; c++)
+        {
+          if(heap[c] < heap[best])
+          {
+            best = c;
+          }
+        }
+        if(!(heap[best] < h))
+        {
+          break;
+        }
+        place(i, heap[best]);
+        i = best;
+      }
+      place(i, h);
+    }
+    // (cost, id) pairs in heap order
+    std::vector<Entry> heap;
+    // pos[id] = slot of id in heap, or -1 if id is not queued
+    std::vector<int> pos;
+  };
+}
+#endif
@@ -0,0 +1,176 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "ProgressiveMesh.h"
+#include "circulation.h"
+#include "collapse_edge.h"
+#include <algorithm>
+#include <cassert>
+
+IGL_INLINE void igl::ProgressiveMesh::clear(const int a_dim)
+{
+	dim = a_dim;
+	applied = 0;
+	collapses.clear();
+	corners.clear();
+	faces.clear();
+	positions.clear();
+	staged_edges.clear();
+	staged_collapses.clear();
+	staged_corners.clear();
+	staged_faces.clear();
+	staged_positions.clear();
+	staged_head = 0;
+}
+
+IGL_INLINE void igl::ProgressiveMesh::begin_collapse(
+	const int e,
+	const Eigen::RowVectorXd& p,
+	const Eigen::MatrixXd& V,
+	const Eigen::MatrixXi& F,
+	const Eigen::MatrixXi& E,
+	const Eigen::VectorXi& EMAP,
+	const Eigen::MatrixXi& EF,
+	const Eigen::MatrixXi& EI)
+{
+	assert(applied == size() && "can only record at the end of the log");
+	assert(V.cols() == dim);
+	// Same conventions as collapse_edge: s < d survives, f1/f2 are the faces
+	// on side 0/1 of e
+	const int eflip = E(e, 0) > E(e, 1);
+	Collapse c;
+	c.s = eflip ? E(e, 1) : E(e, 0);
+	c.d = eflip ? E(e, 0) : E(e, 1);
+	c.f1 = EF(e, 0);
+	c.f2 = EF(e, 1);
+	for (int k = 0; k < 3; k++)
+	{
+		c.F1[k] = F(c.f1, k);
+		c.F2[k] = F(c.f2, k);
+	}
+	c.corners_begin = (int)staged_corners.size();
+	c.faces_begin = (int)staged_faces.size();
+	const int m = F.rows();
+	for (const int f : circulation(e, !eflip, EMAP, EF, EI))
+	{
+		if (f == c.f1 || f == c.f2)
+			continue;
+		for (int k = 0; k < 3; k++)
+			if (F(f, k) == c.d)
+				staged_corners.push_back(f + m * k);
+		staged_faces.push_back(f);
+	}
+	for (const int f : circulation(e, eflip, EMAP, EF, EI))
+	{
+		if (f != c.f1 && f != c.f2)
+			staged_faces.push_back(f);
+	}
+	c.corners_end = (int)staged_corners.size();
+	c.faces_end = (int)staged_faces.size();
+	for (int k = 0; k < dim; k++)
+		staged_positions.push_back(V(c.s, k));
+	for (int k = 0; k < dim; k++)
+		staged_positions.push_back(V(c.d, k));
+	for (int k = 0; k < dim; k++)
+		staged_positions.push_back(p(k));
+	staged_edges.push_back(e);
+	staged_collapses.push_back(c);
+}
+
+IGL_INLINE void igl::ProgressiveMesh::end_collapse(const int e, const bool collapsed)
+{
+	if (staged_head >= (int)staged_edges.size() || staged_edges[staged_head] != e)
+	{
+		// Not begun (e.g. vetoed before begin_collapse)
+		return;
+	}
+	if (collapsed)
+	{
+		Collapse c = staged_collapses[staged_head];
+		const int begin = (int)corners.size();
+		corners.insert(corners.end(), staged_corners.begin() + c.corners_begin, staged_corners.begin() + c.corners_end);
+		c.corners_begin = begin;
+		c.corners_end = (int)corners.size();
+		const int faces_begin = (int)faces.size();
+		faces.insert(faces.end(), staged_faces.begin() + c.faces_begin, staged_faces.begin() + c.faces_end);
+		c.faces_begin = faces_begin;
+		c.faces_end = (int)faces.size();
+		positions.insert(positions.end(), staged_positions.begin() + 3 * dim * staged_head, staged_positions.begin() + 3 * dim * (staged_head + 1));
+		collapses.push_back(c);
+		applied++;
+	}
+	staged_head++;
+	if (staged_head == (int)staged_edges.size())
+	{
+		staged_edges.clear();
+		staged_collapses.clear();
+		staged_corners.clear();
+		staged_faces.clear();
+		staged_positions.clear();
+		staged_head = 0;
+	}
+}
+
+IGL_INLINE void igl::ProgressiveMesh::apply(const int i, Eigen::MatrixXd& V, Eigen::MatrixXi& F) const
+{
+	const Collapse& c = collapses[i];
+	const double* p = positions.data() + (3 * i + 2) * dim;
+	for (int k = 0; k < dim; k++)
+	{
+		V(c.s, k) = p[k];
+		V(c.d, k) = p[k];
+	}
+	F.row(c.f1).setConstant(IGL_COLLAPSE_EDGE_NULL);
+	F.row(c.f2).setConstant(IGL_COLLAPSE_EDGE_NULL);
+	int* f = F.data();
+	for (int j = c.corners_begin; j < c.corners_end; j++)
+		f[corners[j]] = c.s;
+}
+
+IGL_INLINE void igl::ProgressiveMesh::undo(const int i, Eigen::MatrixXd& V, Eigen::MatrixXi& F) const
+{
+	const Collapse& c = collapses[i];
+	int* f = F.data();
+	for (int j = c.corners_begin; j < c.corners_end; j++)
+		f[corners[j]] = c.d;
+	for (int k = 0; k < 3; k++)
+	{
+		F(c.f1, k) = c.F1[k];
+		F(c.f2, k) = c.F2[k];
+	}
+	const double* old_s = positions.data() + 3 * i * dim;
+	const double* old_d = old_s + dim;
+	for (int k = 0; k < dim; k++)
+	{
+		V(c.s, k) = old_s[k];
+		V(c.d, k) = old_d[k];
+	}
+}
+
+IGL_INLINE void igl::ProgressiveMesh::seek(int n, Eigen::MatrixXd& V, Eigen::MatrixXi& F)
+{
+	n = std::max(0, std::min(n, size()));
+	for (; applied < n; applied++)
+		apply(applied, V, F);
+	for (; applied > n; applied--)
+		undo(applied - 1, V, F);
+}
+
+IGL_INLINE void igl::ProgressiveMesh::seek_faces(const int num_faces, Eigen::MatrixXd& V, Eigen::MatrixXi& F)
+{
+	// Every collapse removes two faces
+	seek((F.rows() - num_faces) / 2, V, F);
+}
+
+IGL_INLINE void igl::ProgressiveMesh::changed_faces(const int first, const int last, std::vector<int>& a_faces) const
+{
+	for (int i = std::max(0, first); i < std::min(last, size()); i++)
+	{
+		const Collapse& c = collapses[i];
+		a_faces.push_back(c.f1);
+		a_faces.push_back(c.f2);
+		a_faces.insert(a_faces.end(), faces.begin() + c.faces_begin, faces.begin() + c.faces_end);
+	}
+}
@@ -0,0 +1,125 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PROGRESSIVE_MESH_H
+#define IGL_PROGRESSIVE_MESH_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+    // Log of the edge collapses performed on a mesh, in the order they were
+    // done, so that (V,F) can be moved to any recorded level of detail by
+    // replaying collapses forwards or undoing them (vertex splits) backwards.
+    // Seeking costs O(number of collapses crossed), independent of the mesh
+    // size, and touches only the rows each collapse changed.
+    //
+    // Every collapse is stored as its source s and (removed) destination d,
+    // the two faces it killed with their old rows, the face corners that
+    // were moved from d to s, the other faces around s and d, and the old
+    // positions of s and d together with the new position. Everything lives
+    // in a few flat arrays.
+    //
+    // Collapses are recorded with begin_collapse() (before collapse_edge) and
+    // end_collapse() (after it), see progressive_mesh_collapse_edge_callbacks.
+    // Recording is only allowed while (V,F) is at the end of the log; the
+    // edge connectivity used by the decimator always describes that state.
+    class ProgressiveMesh
+    {
+    public:
+        ProgressiveMesh() : dim(3), applied(0), staged_head(0) {}
+        // Drop the log, (V,F) is then taken as the finest level
+        //
+        // Inputs:
+        //   dim  number of columns of V
+        IGL_INLINE void clear(const int dim = 3);
+        // Number of recorded collapses
+        inline int size() const { return (int)collapses.size(); }
+        // Number of recorded collapses currently applied to (V,F)
+        inline int current() const { return applied; }
+        // Number of live faces of a #F face list at the current level
+        inline int num_faces(const Eigen::MatrixXi& F) const { return F.rows() - 2 * applied; }
+        // Remember what collapsing edge e to p is going to change. Must be
+        // called on a valid edge before collapse_edge touches the mesh.
+        //
+        // Inputs:
+        //   e  index into E of edge about to be collapsed
+        //   p  #V.cols() placement of the surviving vertex
+        //   V, F, E, EMAP, EF, EI  mesh and connectivity, see collapse_edge
+        IGL_INLINE void begin_collapse(
+            const int e,
+            const Eigen::RowVectorXd& p,
+            const Eigen::MatrixXd& V,
+            const Eigen::MatrixXi& F,
+            const Eigen::MatrixXi& E,
+            const Eigen::VectorXi& EMAP,
+            const Eigen::MatrixXi& EF,
+            const Eigen::MatrixXi& EI);
+        // Commit (or drop, if collapse_edge failed) the collapse of e begun
+        // with begin_collapse(). Collapses must end in the order they began;
+        // ending an edge that was not begun is a no-op.
+        //
+        // Inputs:
+        //   e  index into E of the edge
+        //   collapsed  whether collapse_edge succeeded
+        IGL_INLINE void end_collapse(const int e, const bool collapsed);
+        // Move (V,F) to the level where the first n recorded collapses are
+        // applied (n is clamped to [0, size()])
+        //
+        // Inputs:
+        //   n  target number of applied collapses
+        //   V  #V by dim vertex positions at level current()
+        //   F  #F by 3 faces at level current()
+        // Outputs:
+        //   V, F  mesh at level n
+        IGL_INLINE void seek(int n, Eigen::MatrixXd& V, Eigen::MatrixXi& F);
+        // Move (V,F) to the recorded level closest to (but not below)
+        // num_faces live faces
+        IGL_INLINE void seek_faces(const int num_faces, Eigen::MatrixXd& V, Eigen::MatrixXi& F);
+        // Faces whose corners or positions are changed by the recorded
+        // collapses first..last-1 (in either direction), e.g. to refresh only
+        // those after a seek
+        //
+        // Inputs:
+        //   first, last  range of recorded collapses
+        // Outputs:
+        //   faces  list of face indices appended to (may repeat)
+        IGL_INLINE void changed_faces(const int first, const int last, std::vector<int>& faces) const;
+    private:
+        struct Collapse
+        {
+            int s, d, f1, f2;
+            // old rows of f1 and f2
+            int F1[3], F2[3];
+            // corners of F (linear indices) changed from d to s are
+            // corners[corners_begin..corners_end)
+            int corners_begin, corners_end;
+            // other faces around s and d are faces[faces_begin..faces_end)
+            int faces_begin, faces_end;
+        };
+        IGL_INLINE void apply(const int i, Eigen::MatrixXd& V, Eigen::MatrixXi& F) const;
+        IGL_INLINE void undo(const int i, Eigen::MatrixXd& V, Eigen::MatrixXi& F) const;
+        int dim;
+        int applied;
+        std::vector<Collapse> collapses;
+        std::vector<int> corners;
+        std::vector<int> faces;
+        // 3 rows of dim per collapse: old V(s), old V(d), new position
+        std::vector<double> positions;
+        // Collapses begun but not ended yet, same layout as above
+        std::vector<int> staged_edges;
+        std::vector<Collapse> staged_collapses;
+        std::vector<int> staged_corners;
+        std::vector<int> staged_faces;
+        std::vector<double> staged_positions;
+        int staged_head;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "ProgressiveMesh.cpp"
+#endif
+#endif
@@ -511,7 +511,8 @@ IGL_INLINE bool igl::collapse_edge_new_impl(
 	int& e1,
 	int& e2,
 	int& f1,
-	int& f2)
+	int& f2,
+	const bool verbose)
 {
 	using namespace Eigen;
 	if (Q.empty())
@@ -546,7 +547,8 @@ IGL_INLINE bool igl::collapse_edge_new_impl(
 	post_collapse(V, F, E, EMAP, EF, EI, Q, Qit, C, e, e1, e2, f1, f2, collapsed);
 	if (collapsed)
 	{
-		std::cout << "edge " << e << ", cost = " << cost << ", new v position (" << C.row(e) << ")" << std::endl;
+		if (verbose)
+			std::cout << "edge " << e << ", cost = " << cost << ", new v position (" << C.row(e) << ")" << std::endl;
 		// Erase the two, other collapsed edges
 		Q.erase(Qit[e1]);
 		Qit[e1] = Q.end();
@@ -588,3 +590,181 @@ IGL_INLINE bool igl::collapse_edge_new_impl(
 	}
 	return collapsed;
 }
+
+IGL_INLINE bool igl::collapse_edge_new_impl(
+	const std::function<void(
+		const int,
+		const Eigen::MatrixXd&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::VectorXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		double&,
+		Eigen::RowVectorXd&)>& cost_and_placement,
+	Eigen::MatrixXd& V,
+	Eigen::MatrixXi& F,
+	Eigen::MatrixXi& E,
+	Eigen::VectorXi& EMAP,
+	Eigen::MatrixXi& EF,
+	Eigen::MatrixXi& EI,
+	IndexedMinHeap& Q,
+	Eigen::MatrixXd& C)
+{
+	int e, e1, e2, f1, f2;
+	const auto always_try = [](
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		) -> bool { return true; };
+	const auto never_care = [](
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)-> void {};
+	return
+		collapse_edge_new_impl(
+			cost_and_placement, always_try, never_care,
+			V, F, E, EMAP, EF, EI, Q, C, e, e1, e2, f1, f2);
+}
+
+IGL_INLINE bool igl::collapse_edge_new_impl(
+	const std::function<void(
+		const int,
+		const Eigen::MatrixXd&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::VectorXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		double&,
+		Eigen::RowVectorXd&)>& cost_and_placement,
+	const std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	const std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse,
+	Eigen::MatrixXd& V,
+	Eigen::MatrixXi& F,
+	Eigen::MatrixXi& E,
+	Eigen::VectorXi& EMAP,
+	Eigen::MatrixXi& EF,
+	Eigen::MatrixXi& EI,
+	IndexedMinHeap& Q,
+	Eigen::MatrixXd& C,
+	int& e,
+	int& e1,
+	int& e2,
+	int& f1,
+	int& f2,
+	const bool verbose,
+	double* popped_cost)
+{
+	using namespace Eigen;
+	if (Q.empty())
+	{
+		// no edges to collapse
+		return false;
+	}
+	const double cost = Q.top().first;
+	if (cost == std::numeric_limits<double>::infinity())
+	{
+		// min cost edge is infinite cost
+		return false;
+	}
+	if (popped_cost)
+		*popped_cost = cost;
+	e = Q.pop().second;
+
+	std::vector<int> N = circulation(e, true, EMAP, EF, EI);
+	std::vector<int> Nd = circulation(e, false, EMAP, EF, EI);
+	N.insert(N.begin(), Nd.begin(), Nd.end());
+	bool collapsed = true;
+	if (pre_collapse(V, F, E, EMAP, EF, EI, Q, C, e))
+	{
+		collapsed = collapse_edge(e, C.row(e), V, F, E, EMAP, EF, EI, e1, e2, f1, f2);
+	}
+	else
+	{
+		// Aborted by pre collapse callback
+		collapsed = false;
+	}
+	post_collapse(V, F, E, EMAP, EF, EI, Q, C, e, e1, e2, f1, f2, collapsed);
+	if (collapsed)
+	{
+		if (verbose)
+			std::cout << "edge " << e << ", cost = " << cost << ", new v position (" << C.row(e) << ")" << std::endl;
+		// Erase the two, other collapsed edges
+		Q.erase(e1);
+		Q.erase(e2);
+
+		// update local neighbors
+		// loop over original face neighbors
+		RowVectorXd place(1, 3);
+		for (auto n : N)
+		{
+			if (F(n, 0) != IGL_COLLAPSE_EDGE_NULL ||
+				F(n, 1) != IGL_COLLAPSE_EDGE_NULL ||
+				F(n, 2) != IGL_COLLAPSE_EDGE_NULL)
+			{
+				for (int v = 0; v < 3; v++)
+				{
+					// get edge id
+					const int ei = EMAP(v * F.rows() + n);
+					// compute cost and potential placement
+					double cost;
+					cost_and_placement(ei, V, F, E, EMAP, EF, EI, cost, place);
+					// Change its key in place
+					Q.update(ei, cost);
+					C.row(ei) = place;
+				}
+			}
+		}
+	}
+	else
+	{
+		// reinsert with infinite weight (the provided cost function must **not**
+		// have given this un-collapsable edge inf cost already)
+		Q.update(e, std::numeric_limits<double>::infinity());
+	}
+	return collapsed;
+}
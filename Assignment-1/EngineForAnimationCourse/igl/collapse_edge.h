@@ -8,7 +8,9 @@
 #ifndef IGL_COLLAPSE_EDGE_H
 #define IGL_COLLAPSE_EDGE_H
 #include "igl_inline.h"
+#include "IndexedMinHeap.h"
 #include <Eigen/Core>
+#include <functional>
 #include <vector>
 #include <set>
 namespace igl
@@ -209,6 +211,11 @@ namespace igl
     int & f1,
     int & f2);
 
+  // Same as collapse_edge with a std::set queue, but the cost and placement
+  // of the neighbouring edges come from cost_and_placement.
+  //
+  // Inputs (of the overload with callbacks):
+  //   verbose  whether to print each collapse to std::cout
   IGL_INLINE bool collapse_edge_new_impl(
       const std::function<void(
           const int,
@@ -283,7 +290,92 @@ namespace igl
       int& e1,
       int& e2,
       int& f1,
-      int& f2);
+      int& f2,
+      const bool verbose = false);
+
+  // Same as above, but the queue is an indexed min-heap (see IndexedMinHeap)
+  // instead of a std::set and iterator list: neighbouring edges have their
+  // cost changed in place rather than being erased and re-inserted.
+  //
+  // Inputs/Outputs:
+  //   Q  heap of edge costs keyed by edge index
+  // Inputs (of the overload with callbacks):
+  //   verbose  whether to print each collapse to std::cout
+  // Outputs:
+  //   popped_cost  if not NULL, set to the cost of the edge taken from Q
+  IGL_INLINE bool collapse_edge_new_impl(
+      const std::function<void(
+          const int,
+          const Eigen::MatrixXd&,
+          const Eigen::MatrixXi&,
+          const Eigen::MatrixXi&,
+          const Eigen::VectorXi&,
+          const Eigen::MatrixXi&,
+          const Eigen::MatrixXi&,
+          double&,
+          Eigen::RowVectorXd&)>& cost_and_placement,
+      Eigen::MatrixXd& V,
+      Eigen::MatrixXi& F,
+      Eigen::MatrixXi& E,
+      Eigen::VectorXi& EMAP,
+      Eigen::MatrixXi& EF,
+      Eigen::MatrixXi& EI,
+      IndexedMinHeap& Q,
+      Eigen::MatrixXd& C);
+
+  IGL_INLINE bool collapse_edge_new_impl(
+      const std::function<void(
+          const int,
+          const Eigen::MatrixXd&,
+          const Eigen::MatrixXi&,
+          const Eigen::MatrixXi&,
+          const Eigen::VectorXi&,
+          const Eigen::MatrixXi&,
+          const Eigen::MatrixXi&,
+          double&,
+          Eigen::RowVectorXd&)>& cost_and_placement,
+      const std::function<bool(
+          const Eigen::MatrixXd&,/*V*/
+          const Eigen::MatrixXi&,/*F*/
+          const Eigen::MatrixXi&,/*E*/
+          const Eigen::VectorXi&,/*EMAP*/
+          const Eigen::MatrixXi&,/*EF*/
+          const Eigen::MatrixXi&,/*EI*/
+          const IndexedMinHeap&,/*Q*/
+          const Eigen::MatrixXd&,/*C*/
+          const int                                                        /*e*/
+          )>& pre_collapse,
+      const std::function<void(
+          const Eigen::MatrixXd&,   /*V*/
+          const Eigen::MatrixXi&,   /*F*/
+          const Eigen::MatrixXi&,   /*E*/
+          const Eigen::VectorXi&,/*EMAP*/
+          const Eigen::MatrixXi&,  /*EF*/
+          const Eigen::MatrixXi&,  /*EI*/
+          const IndexedMinHeap&,   /*Q*/
+          const Eigen::MatrixXd&,   /*C*/
+          const int,   /*e*/
+          const int,  /*e1*/
+          const int,  /*e2*/
+          const int,  /*f1*/
+          const int,  /*f2*/
+          const bool                                                  /*collapsed*/
+          )>& post_collapse,
+      Eigen::MatrixXd& V,
+      Eigen::MatrixXi& F,
+      Eigen::MatrixXi& E,
+      Eigen::VectorXi& EMAP,
+      Eigen::MatrixXi& EF,
+      Eigen::MatrixXi& EI,
+      IndexedMinHeap& Q,
+      Eigen::MatrixXd& C,
+      int& e,
+      int& e1,
+      int& e2,
+      int& f1,
+      int& f2,
+      const bool verbose = false,
+      double* popped_cost = NULL);
 }
 
 
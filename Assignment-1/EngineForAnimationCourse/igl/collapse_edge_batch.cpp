@@ -0,0 +1,190 @@
+#include "collapse_edge_batch.h"
+#include "collapse_edge.h"
+#include "circulation.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <vector>
+
+IGL_INLINE int igl::collapse_edge_batch(
+	const std::function<void(
+		const int,
+		const Eigen::MatrixXd&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::VectorXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		double&,
+		Eigen::RowVectorXd&)>& cost_and_placement,
+	const std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	const std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse,
+	const int max_collapses,
+	const double max_cost,
+	Eigen::MatrixXd& V,
+	Eigen::MatrixXi& F,
+	Eigen::MatrixXi& E,
+	Eigen::VectorXi& EMAP,
+	Eigen::MatrixXi& EF,
+	Eigen::MatrixXi& EI,
+	IndexedMinHeap& Q,
+	Eigen::MatrixXd& C)
+{
+	const double inf = std::numeric_limits<double>::infinity();
+	// One selected collapse: its edge, the faces around its end points (whose
+	// edges need new costs afterwards) and what collapse_edge reported
+	struct Collapse
+	{
+		int e, e1, e2, f1, f2;
+		bool collapsed;
+		std::vector<int> N;
+		std::vector<std::pair<int, double> > costs;
+	};
+	std::vector<Collapse> batch;
+	std::vector<IndexedMinHeap::Entry> deferred;
+	// marked(v) iff v is in the footprint of a collapse selected this round
+	std::vector<char> marked(V.rows(), 0);
+	std::vector<int> footprint;
+	std::vector<Eigen::RowVectorXd> places;
+
+	int num_collapsed = 0;
+	while (num_collapsed < max_collapses)
+	{
+		// Select an independent set among the cheapest edges. Only look at a
+		// window of the queue so the order stays close to the greedy one.
+		const int remaining = max_collapses - num_collapsed;
+		const int window = std::min(remaining, std::max(1, Q.size() / 8));
+		batch.clear();
+		deferred.clear();
+		footprint.clear();
+		int vetoed = 0;
+		for (int scanned = 0; scanned < window && !Q.empty(); scanned++)
+		{
+			const IndexedMinHeap::Entry top = Q.top();
+			if (top.first == inf || top.first > max_cost)
+				break;
+			Q.pop();
+			const int e = top.second;
+			std::vector<int> N = circulation(e, true, EMAP, EF, EI);
+			std::vector<int> Nd = circulation(e, false, EMAP, EF, EI);
+			N.insert(N.begin(), Nd.begin(), Nd.end());
+			bool independent = true;
+			for (int f : N)
+				for (int c = 0; c < 3; c++)
+					independent = independent && !marked[F(f, c)];
+			if (!independent)
+			{
+				deferred.push_back(top);
+				continue;
+			}
+			if (!pre_collapse(V, F, E, EMAP, EF, EI, Q, C, e))
+			{
+				// Aborted by pre collapse callback, as in collapse_edge_new_impl
+				Q.update(e, inf);
+				vetoed++;
+				continue;
+			}
+			for (int f : N)
+				for (int c = 0; c < 3; c++)
+					if (!marked[F(f, c)])
+					{
+						marked[F(f, c)] = 1;
+						footprint.push_back(F(f, c));
+					}
+			batch.push_back(Collapse());
+			batch.back().e = e;
+			batch.back().N.swap(N);
+		}
+		for (const auto& entry : deferred)
+			Q.update(entry.second, entry.first);
+		for (int v : footprint)
+			marked[v] = 0;
+		if (batch.empty())
+		{
+			if (vetoed > 0)
+				continue;
+			break;
+		}
+
+		// Collapse the independent set concurrently
+		igl::parallel_for((int)batch.size(), [&](const int b)
+		{
+			Collapse& c = batch[b];
+			c.collapsed = collapse_edge(c.e, C.row(c.e), V, F, E, EMAP, EF, EI, c.e1, c.e2, c.f1, c.f2);
+		}, 64);
+		for (const auto& c : batch)
+			post_collapse(V, F, E, EMAP, EF, EI, Q, C, c.e, c.e1, c.e2, c.f1, c.f2, c.collapsed);
+
+		// Recompute the costs around each collapse concurrently. The mesh is
+		// only read from here on, and the edges around two collapses are
+		// distinct, so each writes its own rows of C.
+		igl::parallel_for((int)batch.size(),
+			[&places](const size_t n) { places.assign(n, Eigen::RowVectorXd(1, 3)); },
+			[&](const int b, const size_t t)
+			{
+				Collapse& c = batch[b];
+				c.costs.clear();
+				if (!c.collapsed)
+					return;
+				for (int n : c.N)
+				{
+					if (F(n, 0) == IGL_COLLAPSE_EDGE_NULL &&
+						F(n, 1) == IGL_COLLAPSE_EDGE_NULL &&
+						F(n, 2) == IGL_COLLAPSE_EDGE_NULL)
+						continue;
+					for (int v = 0; v < 3; v++)
+					{
+						const int ei = EMAP(v * F.rows() + n);
+						double cost;
+						cost_and_placement(ei, V, F, E, EMAP, EF, EI, cost, places[t]);
+						C.row(ei) = places[t];
+						c.costs.emplace_back(ei, cost);
+					}
+				}
+			},
+			[](const size_t) {},
+			64);
+
+		for (const auto& c : batch)
+		{
+			if (c.collapsed)
+			{
+				Q.erase(c.e1);
+				Q.erase(c.e2);
+				for (const auto& ec : c.costs)
+					Q.update(ec.first, ec.second);
+				num_collapsed++;
+			}
+			else
+			{
+				// reinsert with infinite weight
+				Q.update(c.e, inf);
+			}
+		}
+	}
+	return num_collapsed;
+}
@@ -0,0 +1,87 @@
+#ifndef IGL_COLLAPSE_EDGE_BATCH_H
+#define IGL_COLLAPSE_EDGE_BATCH_H
+#include "igl_inline.h"
+#include "IndexedMinHeap.h"
+#include <Eigen/Core>
+#include <functional>
+#include <limits>
+namespace igl
+{
+    // Collapse many edges from the queue at once, in rounds. Each round takes
+    // the cheapest edges of Q in order and keeps those whose footprint (all
+    // vertices of the faces around both end points) does not overlap the
+    // footprint of an edge already kept, i.e. an independent set of
+    // collapses. The kept edges are collapsed concurrently, then the costs of
+    // the edges around them are recomputed concurrently and written back to Q.
+    // Rounds repeat until max_collapses edges were collapsed, the cheapest
+    // edge costs more than max_cost, or nothing is left to collapse.
+    //
+    // Disjoint footprints mean collapse_edge of two kept edges never touches
+    // the same rows of V, F, E, EMAP, EF, EI or C. pre_collapse is called
+    // while selecting and post_collapse after each round, both from the
+    // calling thread in queue order; cost_and_placement is called from
+    // several threads at once and must only read its inputs.
+    //
+    // Inputs:
+    //   cost_and_placement  see collapse_edge_new_impl
+    //   pre_collapse  see collapse_edge_new_impl
+    //   post_collapse  see collapse_edge_new_impl
+    //   max_collapses  stop after this many collapses (each removes 2 faces)
+    //   max_cost  stop when the cheapest edge costs more than this {inf}
+    // Inputs/Outputs:
+    //   V, F, E, EMAP, EF, EI, Q, C  see collapse_edge_new_impl
+    // Returns number of collapsed edges
+    IGL_INLINE int collapse_edge_batch(
+        const std::function<void(
+            const int,
+            const Eigen::MatrixXd&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::VectorXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            double&,
+            Eigen::RowVectorXd&)>& cost_and_placement,
+        const std::function<bool(
+            const Eigen::MatrixXd&,/*V*/
+            const Eigen::MatrixXi&,/*F*/
+            const Eigen::MatrixXi&,/*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,/*EF*/
+            const Eigen::MatrixXi&,/*EI*/
+            const IndexedMinHeap&,/*Q*/
+            const Eigen::MatrixXd&,/*C*/
+            const int                                                        /*e*/
+            )>& pre_collapse,
+        const std::function<void(
+            const Eigen::MatrixXd&,   /*V*/
+            const Eigen::MatrixXi&,   /*F*/
+            const Eigen::MatrixXi&,   /*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,  /*EF*/
+            const Eigen::MatrixXi&,  /*EI*/
+            const IndexedMinHeap&,   /*Q*/
+            const Eigen::MatrixXd&,   /*C*/
+            const int,   /*e*/
+            const int,  /*e1*/
+            const int,  /*e2*/
+            const int,  /*f1*/
+            const int,  /*f2*/
+            const bool                                                  /*collapsed*/
+            )>& post_collapse,
+        const int max_collapses,
+        const double max_cost,
+        Eigen::MatrixXd& V,
+        Eigen::MatrixXi& F,
+        Eigen::MatrixXi& E,
+        Eigen::VectorXi& EMAP,
+        Eigen::MatrixXi& EF,
+        Eigen::MatrixXi& EI,
+        IndexedMinHeap& Q,
+        Eigen::MatrixXd& C);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "collapse_edge_batch.cpp"
+#endif
+#endif
@@ -0,0 +1,72 @@
+#include "collapse_edges.h"
+#include "collapse_edge.h"
+#include <limits>
+
+IGL_INLINE int igl::collapse_edges(
+	const std::function<void(
+		const int,
+		const Eigen::MatrixXd&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::VectorXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		double&,
+		Eigen::RowVectorXd&)>& cost_and_placement,
+	const std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	const std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse,
+	const int max_collapses,
+	const double max_cost,
+	Eigen::MatrixXd& V,
+	Eigen::MatrixXi& F,
+	Eigen::MatrixXi& E,
+	Eigen::VectorXi& EMAP,
+	Eigen::MatrixXi& EF,
+	Eigen::MatrixXi& EI,
+	IndexedMinHeap& Q,
+	Eigen::MatrixXd& C,
+	std::vector<double>& costs)
+{
+	int num_collapsed = 0;
+	int e, e1, e2, f1, f2;
+	while (num_collapsed < max_collapses && !Q.empty())
+	{
+		const double top = Q.top().first;
+		if (top == std::numeric_limits<double>::infinity() || top > max_cost)
+			break;
+		// An edge that cannot be collapsed goes back with infinite cost
+		double cost;
+		if (collapse_edge_new_impl(cost_and_placement, pre_collapse, post_collapse,
+			V, F, E, EMAP, EF, EI, Q, C, e, e1, e2, f1, f2, false, &cost))
+		{
+			costs.push_back(cost);
+			num_collapsed++;
+		}
+	}
+	return num_collapsed;
+}
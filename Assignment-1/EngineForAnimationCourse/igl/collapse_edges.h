@@ -0,0 +1,82 @@
+#ifndef IGL_COLLAPSE_EDGES_H
+#define IGL_COLLAPSE_EDGES_H
+#include "igl_inline.h"
+#include "IndexedMinHeap.h"
+#include <Eigen/Core>
+#include <functional>
+#include <vector>
+namespace igl
+{
+    // Collapse the cheapest edges of Q one at a time by calling the
+    // IndexedMinHeap overload of collapse_edge_new_impl, without printing
+    // every collapse and without giving up at the first edge that cannot be
+    // collapsed (it is re-queued with infinite cost as usual).
+    // Stops after max_collapses collapses, when the cheapest edge costs more
+    // than max_cost, or when nothing is left to collapse. Meant for headless
+    // use (tools, benchmarks), where each mesh is decimated on its own thread.
+    //
+    // Inputs:
+    //   cost_and_placement  see collapse_edge_new_impl
+    //   pre_collapse  see collapse_edge_new_impl
+    //   post_collapse  see collapse_edge_new_impl
+    //   max_collapses  stop after this many collapses (each removes 2 faces)
+    //   max_cost  stop when the cheapest edge costs more than this
+    // Inputs/Outputs:
+    //   V, F, E, EMAP, EF, EI, Q, C  see collapse_edge_new_impl
+    //   costs  cost of every collapse done is appended, in order
+    // Returns number of collapsed edges
+    IGL_INLINE int collapse_edges(
+        const std::function<void(
+            const int,
+            const Eigen::MatrixXd&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::VectorXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            double&,
+            Eigen::RowVectorXd&)>& cost_and_placement,
+        const std::function<bool(
+            const Eigen::MatrixXd&,/*V*/
+            const Eigen::MatrixXi&,/*F*/
+            const Eigen::MatrixXi&,/*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,/*EF*/
+            const Eigen::MatrixXi&,/*EI*/
+            const IndexedMinHeap&,/*Q*/
+            const Eigen::MatrixXd&,/*C*/
+            const int                                                        /*e*/
+            )>& pre_collapse,
+        const std::function<void(
+            const Eigen::MatrixXd&,   /*V*/
+            const Eigen::MatrixXi&,   /*F*/
+            const Eigen::MatrixXi&,   /*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,  /*EF*/
+            const Eigen::MatrixXi&,  /*EI*/
+            const IndexedMinHeap&,   /*Q*/
+            const Eigen::MatrixXd&,   /*C*/
+            const int,   /*e*/
+            const int,  /*e1*/
+            const int,  /*e2*/
+            const int,  /*f1*/
+            const int,  /*f2*/
+            const bool                                                  /*collapsed*/
+            )>& post_collapse,
+        const int max_collapses,
+        const double max_cost,
+        Eigen::MatrixXd& V,
+        Eigen::MatrixXi& F,
+        Eigen::MatrixXi& E,
+        Eigen::VectorXi& EMAP,
+        Eigen::MatrixXi& EF,
+        Eigen::MatrixXi& EI,
+        IndexedMinHeap& Q,
+        Eigen::MatrixXd& C,
+        std::vector<double>& costs);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "collapse_edges.cpp"
+#endif
+#endif
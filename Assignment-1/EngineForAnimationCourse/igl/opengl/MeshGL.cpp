@@ -80,6 +80,38 @@ IGL_INLINE void igl::opengl::MeshGL::bind_mesh()
 	bind_vertex_attrib_array(shader_mesh, "Ks", vbo_V_specular, V_specular_vbo, dirty & MeshGL::DIRTY_SPECULAR);
 	bind_vertex_attrib_array(shader_mesh, "texcoord", vbo_V_uv, V_uv_vbo, dirty & MeshGL::DIRTY_UV);
 
+	// Upload only the rows of the slots that changed, merging runs of
+	// consecutive slots into one call per buffer
+	if ((dirty & MeshGL::DIRTY_FACE_SUBSET) && !(dirty & MeshGL::DIRTY_MESH))
+	{
+		const auto sub_data = [](GLuint bufferID, const RowMatrixXf& M, const int begin, const int end)
+		{
+			if (M.size() == 0)
+				return;
+			glBindBuffer(GL_ARRAY_BUFFER, bufferID);
+			glBufferSubData(GL_ARRAY_BUFFER,
+				sizeof(float) * 3 * begin * M.cols(),
+				sizeof(float) * 3 * (end - begin) * M.cols(),
+				M.data() + 3 * begin * M.cols());
+		};
+		for (size_t i = 0; i < dirty_slots.size();)
+		{
+			size_t j = i + 1;
+			while (j < dirty_slots.size() && dirty_slots[j] == dirty_slots[j - 1] + 1)
+				j++;
+			const int begin = dirty_slots[i];
+			const int end = dirty_slots[j - 1] + 1;
+			sub_data(vbo_V, V_vbo, begin, end);
+			sub_data(vbo_V_normals, V_normals_vbo, begin, end);
+			sub_data(vbo_V_ambient, V_ambient_vbo, begin, end);
+			sub_data(vbo_V_diffuse, V_diffuse_vbo, begin, end);
+			sub_data(vbo_V_specular, V_specular_vbo, begin, end);
+			sub_data(vbo_V_uv, V_uv_vbo, begin, end);
+			i = j;
+		}
+	}
+	dirty_slots.clear();
+
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbo_F);
 	if (dirty & MeshGL::DIRTY_FACE)
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned) * F_vbo.size(), F_vbo.data(), GL_DYNAMIC_DRAW);
@@ -96,7 +128,7 @@ IGL_INLINE void igl::opengl::MeshGL::bind_mesh()
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex_u, tex_v, 0, GL_RGBA, GL_UNSIGNED_BYTE, tex.data());
 	}
 	glUniform1i(glGetUniformLocation(shader_mesh, "tex"), 0);
-	dirty &= ~MeshGL::DIRTY_MESH;
+	dirty &= ~(MeshGL::DIRTY_MESH | MeshGL::DIRTY_FACE_SUBSET);
 }
 
 IGL_INLINE void igl::opengl::MeshGL::bind_overlay_lines()
@@ -141,7 +173,8 @@ IGL_INLINE void igl::opengl::MeshGL::draw_mesh(bool solid)
 		glEnable(GL_POLYGON_OFFSET_FILL);
 		glPolygonOffset(1.0, 1.0);
 	}
-	glDrawElements(GL_TRIANGLES, 3 * F_vbo.rows(), GL_UNSIGNED_INT, 0);
+	const int num_faces = compact_faces ? (int)slot_F.size() : (int)F_vbo.rows();
+	glDrawElements(GL_TRIANGLES, 3 * num_faces, GL_UNSIGNED_INT, 0);
 
 	glDisable(GL_POLYGON_OFFSET_FILL);
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
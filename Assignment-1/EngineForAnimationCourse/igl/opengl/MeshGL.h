@@ -14,6 +14,7 @@
 
 #include <igl/igl_inline.h>
 #include <Eigen/Core>
+#include <vector>
 
 namespace igl
 {
@@ -39,7 +40,8 @@ public:
     DIRTY_MESH           = 0x00FF,
     DIRTY_OVERLAY_LINES  = 0x0100,
     DIRTY_OVERLAY_POINTS = 0x0200,
-    DIRTY_ALL            = 0x03FF
+    DIRTY_FACE_SUBSET    = 0x0400, // Only the faces in ViewerData::dirty_faces changed
+    DIRTY_ALL            = 0x07FF
   };
 
   bool is_initialized = false;
@@ -88,6 +90,15 @@ public:
   Eigen::Matrix<unsigned, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> lines_F_vbo;
   Eigen::Matrix<unsigned, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> points_F_vbo;
 
+  // Face based layout: the per corner buffers hold the live faces packed at
+  // the front, slot k being corners 3k..3k+2 of face slot_F[k]. Dead faces
+  // (all three indices equal, as left by collapse_edge) are neither uploaded
+  // nor drawn.
+  bool compact_faces = false;
+  Eigen::VectorXi F_slot; // Slot of every face, -1 if dead (#F)
+  std::vector<int> slot_F; // Face in every slot (#live faces)
+  std::vector<int> dirty_slots; // Slots to upload with glBufferSubData
+
   // Marks dirty buffers that need to be uploaded to OpenGL
   uint32_t dirty;
 
@@ -122,6 +122,7 @@ IGL_INLINE void igl::opengl::ViewerCore::draw(
 	{
 		data.updateGL(data, data.invert_normals, data.meshgl);
 		data.dirty = MeshGL::DIRTY_NONE;
+		data.dirty_faces.clear();
 	}
 	data.meshgl.bind_mesh();
 
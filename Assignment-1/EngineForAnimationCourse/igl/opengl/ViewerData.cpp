@@ -15,6 +15,7 @@
 #include "../per_vertex_normals.h"
 #include "igl/png/texture_from_png.h"
 #include <iostream>
+#include <algorithm>
 #include <igl/collapse_edge.h>
 #include <igl/edge_flaps.h>
 #include <igl/shortest_edge_and_midpoint.h>
@@ -400,6 +401,26 @@ IGL_INLINE void igl::opengl::ViewerData::compute_normals()
 	dirty |= MeshGL::DIRTY_NORMAL;
 }
 
+IGL_INLINE void igl::opengl::ViewerData::update_faces(const std::vector<int>& faces)
+{
+	if (!face_based || F_normals.rows() != F.rows())
+	{
+		compute_normals();
+		dirty |= MeshGL::DIRTY_FACE | MeshGL::DIRTY_POSITION;
+		return;
+	}
+	for (const int f : faces)
+	{
+		const Eigen::RowVector3d v1 = V.row(F(f, 1)) - V.row(F(f, 0));
+		const Eigen::RowVector3d v2 = V.row(F(f, 2)) - V.row(F(f, 0));
+		const Eigen::RowVector3d n = v1.cross(v2);
+		const double r = n.norm();
+		F_normals.row(f) = r == 0 ? Eigen::RowVector3d::Zero() : Eigen::RowVector3d(n / r);
+	}
+	dirty_faces.insert(dirty_faces.end(), faces.begin(), faces.end());
+	dirty |= MeshGL::DIRTY_FACE_SUBSET;
+}
+
 IGL_INLINE void igl::opengl::ViewerData::uniform_colors(
 	const Eigen::Vector3d& ambient,
 	const Eigen::Vector3d& diffuse,
@@ -513,21 +534,6 @@ IGL_INLINE void igl::opengl::ViewerData::updateGL(
 
 	meshgl.dirty |= data.dirty;
 
-	// Input:
-	//   X  #F by dim quantity
-	// Output:
-	//   X_vbo  #F*3 by dim scattering per corner
-	const auto per_face = [&data](
-		const Eigen::MatrixXd& X,
-		MeshGL::RowMatrixXf& X_vbo)
-	{
-		assert(X.cols() == 4);
-		X_vbo.resize(data.F.rows() * 3, 4);
-		for (unsigned i = 0; i < data.F.rows(); ++i)
-			for (unsigned j = 0; j < 3; ++j)
-				X_vbo.row(i * 3 + j) = X.row(i).cast<float>();
-	};
-
 	// Input:
 	//   X  #V by dim quantity
 	// Output:
@@ -642,50 +648,131 @@ IGL_INLINE void igl::opengl::ViewerData::updateGL(
 	}
 	else
 	{
-		if (meshgl.dirty & MeshGL::DIRTY_POSITION)
+		const auto is_dead = [&data](const int f)
 		{
-			per_corner(data.V, meshgl.V_vbo);
-		}
-		if (meshgl.dirty & MeshGL::DIRTY_AMBIENT)
-		{
-			per_face(data.F_material_ambient, meshgl.V_ambient_vbo);
-		}
-		if (meshgl.dirty & MeshGL::DIRTY_DIFFUSE)
+			return data.F(f, 0) == data.F(f, 1) && data.F(f, 1) == data.F(f, 2);
+		};
+		// Write the corners of the face in slot k into the buffers selected by
+		// flags
+		const auto fill_slot = [&data, &meshgl, per_corner_uv, per_corner_normals, invert_normals](
+			const int k, const uint32_t flags)
 		{
-			per_face(data.F_material_diffuse, meshgl.V_diffuse_vbo);
-		}
-		if (meshgl.dirty & MeshGL::DIRTY_SPECULAR)
-		{
-			per_face(data.F_material_specular, meshgl.V_specular_vbo);
-		}
-
-		if (meshgl.dirty & MeshGL::DIRTY_NORMAL)
-		{
-			meshgl.V_normals_vbo.resize(data.F.rows() * 3, 3);
-			for (unsigned i = 0; i < data.F.rows(); ++i)
-				for (unsigned j = 0; j < 3; ++j)
-					meshgl.V_normals_vbo.row(i * 3 + j) =
-					per_corner_normals ?
-					data.F_normals.row(i * 3 + j).cast<float>() :
-					data.F_normals.row(i).cast<float>();
-
-			if (invert_normals)
-				meshgl.V_normals_vbo = -meshgl.V_normals_vbo;
-		}
+			const int f = meshgl.slot_F[k];
+			for (int j = 0; j < 3; ++j)
+			{
+				const int c = 3 * k + j;
+				if (flags & MeshGL::DIRTY_POSITION)
+					meshgl.V_vbo.row(c) = data.V.row(data.F(f, j)).cast<float>();
+				if (flags & MeshGL::DIRTY_AMBIENT)
+					meshgl.V_ambient_vbo.row(c) = data.F_material_ambient.row(f).cast<float>();
+				if (flags & MeshGL::DIRTY_DIFFUSE)
+					meshgl.V_diffuse_vbo.row(c) = data.F_material_diffuse.row(f).cast<float>();
+				if (flags & MeshGL::DIRTY_SPECULAR)
+					meshgl.V_specular_vbo.row(c) = data.F_material_specular.row(f).cast<float>();
+				if (flags & MeshGL::DIRTY_NORMAL)
+				{
+					meshgl.V_normals_vbo.row(c) =
+						per_corner_normals ?
+						data.F_normals.row(f * 3 + j).cast<float>() :
+						data.F_normals.row(f).cast<float>();
+					if (invert_normals)
+						meshgl.V_normals_vbo.row(c) = -meshgl.V_normals_vbo.row(c);
+				}
+				if ((flags & MeshGL::DIRTY_UV) && data.V_uv.rows() > 0)
+					meshgl.V_uv_vbo.row(c) = data.V_uv.row(per_corner_uv ? data.F_uv(f, j) : data.F(f, j)).cast<float>();
+			}
+		};
+		const uint32_t per_corner_flags = MeshGL::DIRTY_POSITION | MeshGL::DIRTY_UV | MeshGL::DIRTY_NORMAL |
+			MeshGL::DIRTY_AMBIENT | MeshGL::DIRTY_DIFFUSE | MeshGL::DIRTY_SPECULAR;
 
+		if (!meshgl.compact_faces || meshgl.F_slot.rows() != data.F.rows())
+			meshgl.dirty |= MeshGL::DIRTY_FACE;
 		if (meshgl.dirty & MeshGL::DIRTY_FACE)
 		{
+			// Pack the live faces, every buffer follows the new order
+			meshgl.compact_faces = true;
+			meshgl.F_slot.setConstant(data.F.rows(), -1);
+			meshgl.slot_F.clear();
+			for (int f = 0; f < data.F.rows(); ++f)
+			{
+				if (!is_dead(f))
+				{
+					meshgl.F_slot(f) = (int)meshgl.slot_F.size();
+					meshgl.slot_F.push_back(f);
+				}
+			}
 			meshgl.F_vbo.resize(data.F.rows(), 3);
 			for (unsigned i = 0; i < data.F.rows(); ++i)
 				meshgl.F_vbo.row(i) << i * 3 + 0, i * 3 + 1, i * 3 + 2;
+			meshgl.dirty |= per_corner_flags;
+		}
+		else if (meshgl.dirty & MeshGL::DIRTY_FACE_SUBSET)
+		{
+			// Move faces in and out of the packed range, and collect the
+			// slots whose corners changed
+			for (const int f : data.dirty_faces)
+			{
+				const int k = meshgl.F_slot(f);
+				if (is_dead(f))
+				{
+					if (k < 0)
+						continue;
+					// Swap in the last live face
+					const int g = meshgl.slot_F.back();
+					meshgl.slot_F[k] = g;
+					meshgl.F_slot(g) = k;
+					meshgl.slot_F.pop_back();
+					meshgl.F_slot(f) = -1;
+					if (g != f)
+						meshgl.dirty_slots.push_back(k);
+				}
+				else if (k < 0)
+				{
+					meshgl.F_slot(f) = (int)meshgl.slot_F.size();
+					meshgl.slot_F.push_back(f);
+					meshgl.dirty_slots.push_back(meshgl.F_slot(f));
+				}
+				else
+				{
+					meshgl.dirty_slots.push_back(k);
+				}
+			}
+			std::sort(meshgl.dirty_slots.begin(), meshgl.dirty_slots.end());
+			meshgl.dirty_slots.erase(std::unique(meshgl.dirty_slots.begin(), meshgl.dirty_slots.end()), meshgl.dirty_slots.end());
+			while (!meshgl.dirty_slots.empty() && meshgl.dirty_slots.back() >= (int)meshgl.slot_F.size())
+				meshgl.dirty_slots.pop_back();
+			if (meshgl.dirty & per_corner_flags)
+			{
+				// Some buffer is refreshed in full anyway, refresh them all
+				meshgl.dirty |= per_corner_flags;
+			}
+			else
+			{
+				for (const int k : meshgl.dirty_slots)
+					fill_slot(k, per_corner_flags);
+			}
 		}
 
-		if (meshgl.dirty & MeshGL::DIRTY_UV)
+		if (meshgl.dirty & per_corner_flags)
 		{
-			meshgl.V_uv_vbo.resize(data.F.rows() * 3, 2);
-			for (unsigned i = 0; i < data.F.rows(); ++i)
-				for (unsigned j = 0; j < 3; ++j)
-					meshgl.V_uv_vbo.row(i * 3 + j) = data.V_uv.row(per_corner_uv ? data.F_uv(i, j) : data.F(i, j)).cast<float>();
+			// Buffers are sized for all faces, so that faces coming back (e.g.
+			// when undoing collapses) can be appended without reallocating
+			const int num_corners = data.F.rows() * 3;
+			if (meshgl.dirty & MeshGL::DIRTY_POSITION)
+				meshgl.V_vbo.resize(num_corners, 3);
+			if (meshgl.dirty & MeshGL::DIRTY_AMBIENT)
+				meshgl.V_ambient_vbo.resize(num_corners, 4);
+			if (meshgl.dirty & MeshGL::DIRTY_DIFFUSE)
+				meshgl.V_diffuse_vbo.resize(num_corners, 4);
+			if (meshgl.dirty & MeshGL::DIRTY_SPECULAR)
+				meshgl.V_specular_vbo.resize(num_corners, 4);
+			if (meshgl.dirty & MeshGL::DIRTY_NORMAL)
+				meshgl.V_normals_vbo.resize(num_corners, 3);
+			if (meshgl.dirty & MeshGL::DIRTY_UV)
+				meshgl.V_uv_vbo.resize(data.V_uv.rows() > 0 ? num_corners : 0, 2);
+			for (int k = 0; k < (int)meshgl.slot_F.size(); ++k)
+				fill_slot(k, meshgl.dirty);
+			meshgl.dirty_slots.clear();
 		}
 	}
 
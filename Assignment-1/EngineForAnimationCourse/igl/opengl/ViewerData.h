@@ -131,6 +131,16 @@ namespace igl
 			// Computes the normals of the mesh
 			IGL_INLINE void compute_normals();
 
+			// Refresh only the given faces after V and F were changed in place
+			// (e.g. by collapse_edge): recomputes their face normals and uploads
+			// only their corners. Vertex normals are not updated; outside of
+			// face based mode this falls back to compute_normals and a full
+			// upload.
+			//
+			// Inputs:
+			//   faces  list of indices into F whose vertices or positions changed
+			IGL_INLINE void update_faces(const std::vector<int>& faces);
+
 			// Assigns uniform colors to all faces/vertices
 			IGL_INLINE void uniform_colors(
 				const Eigen::Vector3d& diffuse,
@@ -197,6 +207,8 @@ namespace igl
 
 			// Marks dirty buffers that need to be uploaded to OpenGL
 			uint32_t dirty;
+			// Faces passed to update_faces since the last upload
+			std::vector<int> dirty_faces;
 
 			// Enable per-face or per-vertex properties
 			bool face_based;
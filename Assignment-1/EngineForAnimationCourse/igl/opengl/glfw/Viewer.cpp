@@ -45,6 +45,11 @@
 #include <igl/serialize.h>
 
 #include <igl/shortest_edge_and_midpoint.h>
+#include <igl/paper_vertex_quadrics.h>
+#include <igl/paper_quadric_collapse_edge_callbacks.h>
+#include <igl/paper_quadric_edge_costs.h>
+#include <igl/collapse_edge_batch.h>
+#include <igl/progressive_mesh_collapse_edge_callbacks.h>
 
 // Internal global variables used for glfw event handling
 //static igl::opengl::glfw::Viewer * __viewer;
@@ -72,6 +77,8 @@ namespace igl
 				next_data_id(1),
 				isPicked(false),
 				isActive(false),
+				use_heap_queue(true),
+				use_batch_decimation(false),
 				nums_collapsed(10)
 			{
 				data_list.front().id = 0;
@@ -377,55 +384,125 @@ namespace igl
 				EFs[selected_data_index] = new Eigen::MatrixXi();
 				EIs[selected_data_index] = new Eigen::MatrixXi();
 				Qs[selected_data_index] = new Priority_queue();
+				Hs[selected_data_index] = new Heap_queue();
 				Cs[selected_data_index] = new Eigen::MatrixXd();
+				VQs[selected_data_index] = new Vertex_quadrics();
+				PMs[selected_data_index] = new ProgressiveMesh();
+				PMs[selected_data_index]->clear(data().V.cols());
 
 				edge_flaps(data().F, *Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index], *EIs[selected_data_index]);
 				Qits[selected_data_index].resize(Es[selected_data_index]->rows());
+				Hs[selected_data_index]->resize(Es[selected_data_index]->rows());
 				Cs[selected_data_index]->resize(Es[selected_data_index]->rows(), data().V.cols());
-
-
-				Eigen::VectorXd costs(Es[selected_data_index]->rows());
+				paper_vertex_quadrics(data().V, data().F, *VQs[selected_data_index]);
+
+				// Costs and placements are independent per edge: compute them into
+				// flat arrays, vectorized and on all cores, then build the queue in
+				// one go
+				const int num_edges = Es[selected_data_index]->rows();
+				Eigen::VectorXd costs;
+				paper_quadric_edge_costs(*VQs[selected_data_index], data().V, *Es[selected_data_index], costs, *Cs[selected_data_index]);
 				Qs[selected_data_index]->clear();
-				for (int e = 0; e < Es[selected_data_index]->rows(); e++)
+				if (use_heap_queue)
 				{
-					double cost = e;
-					Eigen::RowVectorXd p(1, 3);
-					paper_cost_and_new_vertex(e, data().V, data().F, *Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index], *EIs[selected_data_index], cost, p);
-					Cs[selected_data_index]->row(e) = p;
-					Qits[selected_data_index][e] = Qs[selected_data_index]->insert(std::pair<double, int>(cost, e)).first;
-
+					Hs[selected_data_index]->build(costs);
+				}
+				else
+				{
+					// Sorted bulk load: inserting at the end with a hint is amortized O(1)
+					std::vector<std::pair<double, int>> sorted(num_edges);
+					for (int e = 0; e < num_edges; e++)
+						sorted[e] = std::pair<double, int>(costs(e), e);
+					std::sort(sorted.begin(), sorted.end());
+					for (const auto& entry : sorted)
+						Qits[selected_data_index][entry.second] = Qs[selected_data_index]->insert(Qs[selected_data_index]->end(), entry);
 				}
 			}
 
-			// Function to reset original mesh and data structures
+			// Function to reset original mesh: undo every recorded collapse. The
+			// data structures stay at the end of the log, so decimating again
+			// replays the log first.
 			void Viewer::reset()
 			{
-				data().F = *OFs[selected_data_index];
-				data().V = *OVs[selected_data_index];
-				init_curr_data_structs();
-				nums_collapsed[selected_data_index] = 0;
-				data().compute_normals();
-				data().set_mesh(data().V, data().F);
+				seek_collapses(0);
+			}
+
+			// Move the mesh to n recorded collapses, in either direction
+			void Viewer::seek_collapses(const int n)
+			{
+				const int from = PMs[selected_data_index]->current();
+				PMs[selected_data_index]->seek(n, data().V, data().F);
+				nums_collapsed[selected_data_index] = PMs[selected_data_index]->current();
+				// Only refresh the faces around the collapses crossed
+				std::vector<int> faces;
+				PMs[selected_data_index]->changed_faces(std::min(from, n), std::max(from, n), faces);
 				data().set_face_based(true);
+				data().update_faces(faces);
+			}
+
+			// Undo as many collapses as pre_draw does in one step
+			void Viewer::refine()
+			{
+				const size_t queue_size = use_heap_queue ? Hs[selected_data_index]->size() : Qs[selected_data_index]->size();
+				seek_collapses(PMs[selected_data_index]->current() - (int)std::ceil(0.05 * queue_size));
 			}
 
 			void Viewer::pre_draw()
 			{
 				// If animating then collapse 10% of edges
-				if (!Qs[selected_data_index]->empty())
+				const size_t queue_size = use_heap_queue ? Hs[selected_data_index]->size() : Qs[selected_data_index]->size();
+				const int max_iter = std::ceil(0.05 * queue_size);
+				if (PMs[selected_data_index]->current() < PMs[selected_data_index]->size())
+				{
+					// Coarser levels were already computed, replay them
+					seek_collapses(PMs[selected_data_index]->current() + max_iter);
+					return;
+				}
+				if (queue_size > 0)
 				{
 					bool something_collapsed = false;
+					Cost_and_placement cost_and_placement;
+					Heap_pre_collapse heap_pre_collapse;
+					Heap_post_collapse heap_post_collapse;
+					Set_pre_collapse set_pre_collapse;
+					Set_post_collapse set_post_collapse;
+					// Record every collapse so that levels can be revisited
+					if (use_heap_queue)
+					{
+						paper_quadric_collapse_edge_callbacks(*VQs[selected_data_index], cost_and_placement, heap_pre_collapse, heap_post_collapse);
+						progressive_mesh_collapse_edge_callbacks(*PMs[selected_data_index], heap_pre_collapse, heap_post_collapse);
+					}
+					else
+					{
+						paper_quadric_collapse_edge_callbacks(*VQs[selected_data_index], cost_and_placement, set_pre_collapse, set_post_collapse);
+						progressive_mesh_collapse_edge_callbacks(*PMs[selected_data_index], set_pre_collapse, set_post_collapse);
+					}
+					int e, e1, e2, f1, f2;
+					const int first_collapse = PMs[selected_data_index]->current();
 					// collapse edge
-					const int max_iter = std::ceil(0.05 * Qs[selected_data_index]->size());
-					for (int j = 0; j < max_iter; j++)
+					if (use_heap_queue && use_batch_decimation)
+					{
+						const int collapsed = collapse_edge_batch(cost_and_placement, heap_pre_collapse, heap_post_collapse,
+							max_iter, std::numeric_limits<double>::infinity(), data().V, data().F,
+							*Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index],
+							*EIs[selected_data_index], *Hs[selected_data_index], *Cs[selected_data_index]);
+						something_collapsed = collapsed > 0;
+						nums_collapsed[selected_data_index] += collapsed;
+					}
+					else for (int j = 0; j < max_iter; j++)
 					{
 						// if (!collapse_edge(shortest_edge_and_midpoint, data().V, data().F,
 						// 	*Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index],
 						// 	*EIs[selected_data_index], *Qs[selected_data_index], Qits[selected_data_index], *Cs[selected_data_index]))
 						// {
-						if (!collapse_edge_new_impl(paper_cost_and_new_vertex, data().V, data().F,
-							*Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index],
-							*EIs[selected_data_index], *Qs[selected_data_index], Qits[selected_data_index], *Cs[selected_data_index]))
+						const bool collapsed = use_heap_queue ?
+							collapse_edge_new_impl(cost_and_placement, heap_pre_collapse, heap_post_collapse, data().V, data().F,
+								*Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index],
+								*EIs[selected_data_index], *Hs[selected_data_index], *Cs[selected_data_index], e, e1, e2, f1, f2, true) :
+							collapse_edge_new_impl(cost_and_placement, set_pre_collapse, set_post_collapse, data().V, data().F,
+								*Es[selected_data_index], *EMAPs[selected_data_index], *EFs[selected_data_index],
+								*EIs[selected_data_index], *Qs[selected_data_index], Qits[selected_data_index], *Cs[selected_data_index], e, e1, e2, f1, f2, true);
+						if (!collapsed)
 						{
 							break;
 						}
@@ -434,9 +511,10 @@ namespace igl
 					}
 					if (something_collapsed)
 					{
-						data().compute_normals();
-						data().set_mesh(data().V, data().F);
+						std::vector<int> faces;
+						PMs[selected_data_index]->changed_faces(first_collapse, PMs[selected_data_index]->current(), faces);
 						data().set_face_based(true);
+						data().update_faces(faces);
 					}
 				}
 			}
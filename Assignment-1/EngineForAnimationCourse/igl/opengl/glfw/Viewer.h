@@ -25,9 +25,14 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <functional>
+#include <set>
 
 #include <igl/paper_cost_and_new_vertex.h>
 #include <igl/shortest_edge_and_midpoint.h>
+#include <igl/IndexedMinHeap.h>
+#include <igl/ProgressiveMesh.h>
+#include <Eigen/StdVector>
 
 #define IGL_MOD_SHIFT           0x0001
 #define IGL_MOD_CONTROL         0x0002
@@ -162,8 +167,29 @@ namespace igl
 				typedef std::set<std::pair<double, int>> Priority_queue; // Ordered set of pair<cost, edge index>
 				std::vector<Priority_queue *> Qs{10}; // A priority queue for the Q matrices of the mesh
 				std::vector<std::vector<Priority_queue::iterator>> Qits{10};
+				typedef igl::IndexedMinHeap Heap_queue; // Indexed heap of pair<cost, edge index>
+				std::vector<Heap_queue *> Hs{10}; // Same queue as Qs, used when use_heap_queue is set
+				bool use_heap_queue; // Whether the collapse queue is Hs (indexed heap) or Qs/Qits (std::set)
+				bool use_batch_decimation; // Collapse independent sets of edges in parallel (heap queue only)
 				std::vector<Eigen::MatrixXd *> Cs{10}; // New vertices after collapse
+				typedef std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d>> Vertex_quadrics;
+				std::vector<Vertex_quadrics *> VQs{10}; // Per-vertex quadrics of the mesh, merged on collapse
+				// Callback types of collapse_edge_new_impl
+				typedef std::function<void(const int, const Eigen::MatrixXd&, const Eigen::MatrixXi&, const Eigen::MatrixXi&,
+					const Eigen::VectorXi&, const Eigen::MatrixXi&, const Eigen::MatrixXi&, double&, Eigen::RowVectorXd&)> Cost_and_placement;
+				typedef std::function<bool(const Eigen::MatrixXd&, const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Eigen::VectorXi&,
+					const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Heap_queue&, const Eigen::MatrixXd&, const int)> Heap_pre_collapse;
+				typedef std::function<void(const Eigen::MatrixXd&, const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Eigen::VectorXi&,
+					const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Heap_queue&, const Eigen::MatrixXd&,
+					const int, const int, const int, const int, const int, const bool)> Heap_post_collapse;
+				typedef std::function<bool(const Eigen::MatrixXd&, const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Eigen::VectorXi&,
+					const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Priority_queue&, const std::vector<Priority_queue::iterator>&,
+					const Eigen::MatrixXd&, const int)> Set_pre_collapse;
+				typedef std::function<void(const Eigen::MatrixXd&, const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Eigen::VectorXi&,
+					const Eigen::MatrixXi&, const Eigen::MatrixXi&, const Priority_queue&, const std::vector<Priority_queue::iterator>&,
+					const Eigen::MatrixXd&, const int, const int, const int, const int, const int, const bool)> Set_post_collapse;
 				std::vector<int> nums_collapsed; // Number of collapsed edges for the mesh
+				std::vector<igl::ProgressiveMesh *> PMs{10}; // Log of the collapses done on the mesh, for seeking between LODs
 
 			public:
 				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -171,6 +197,8 @@ namespace igl
 				void init_curr_data_structs();
 				void reset();
 				void pre_draw();
+				void refine();
+				void seek_collapses(const int n);
 				void print_data_structs();
 				inline void set_curr_reset_point()
 				{
@@ -1,5 +1,5 @@
-#ifndef IGL_SHORTEST_EDGE_AND_MIDPOINT_H
-#define IGL_SHORTEST_EDGE_AND_MIDPOINT_H
+#ifndef IGL_PAPER_COST_AND_NEW_VERTEX_H
+#define IGL_PAPER_COST_AND_NEW_VERTEX_H
 #include "igl_inline.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -0,0 +1,196 @@
+#include "paper_quadric_collapse_edge_callbacks.h"
+#include "quadric_cost_and_placement_batch.h"
+#include "edge_collapse_is_valid.h"
+
+namespace
+{
+	typedef std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> > Quadrics;
+
+	// Cost and placement of the sum of the quadrics of the end points
+	struct QuadricCost
+	{
+		const Quadrics* quadrics;
+		void operator()(
+			const int e,
+			const Eigen::MatrixXd& V,
+			const Eigen::MatrixXi&,/*F*/
+			const Eigen::MatrixXi& E,
+			const Eigen::VectorXi&,/*EMAP*/
+			const Eigen::MatrixXi&,/*EF*/
+			const Eigen::MatrixXi&,/*EI*/
+			double& cost,
+			Eigen::RowVectorXd& p) const
+		{
+			Eigen::RowVector3d placement;
+			igl::quadric_cost_and_placement((*quadrics)[E(e, 0)] + (*quadrics)[E(e, 1)], V.row(E(e, 0)), V.row(E(e, 1)), cost, placement);
+			p = placement;
+		}
+	};
+
+	// Both end points end up at the merged vertex, give them the merged
+	// quadric. Only do so for collapses that will go through.
+	bool merge_quadrics(
+		Quadrics& quadrics,
+		const int e,
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI)
+	{
+		if (!igl::edge_collapse_is_valid(e, F, E, EMAP, EF, EI))
+			return false;
+		const Eigen::Matrix4d Q = quadrics[E(e, 0)] + quadrics[E(e, 1)];
+		quadrics[E(e, 0)] = Q;
+		quadrics[E(e, 1)] = Q;
+		return true;
+	}
+}
+
+IGL_INLINE void igl::paper_quadric_collapse_edge_callbacks(
+	std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics,
+	std::function<void(
+		const int,
+		const Eigen::MatrixXd&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::VectorXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		double&,
+		Eigen::RowVectorXd&)>& cost_and_placement,
+	std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const std::set<std::pair<double, int> >&,/*Q*/
+		const std::vector<std::set<std::pair<double, int> >::iterator >&,/*Qit*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const std::set<std::pair<double, int> >&,   /*Q*/
+		const std::vector<std::set<std::pair<double, int> >::iterator >&, /*Qit*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse)
+{
+	cost_and_placement = QuadricCost{ &quadrics };
+	pre_collapse = [&quadrics](
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI,
+		const std::set<std::pair<double, int> >&,/*Q*/
+		const std::vector<std::set<std::pair<double, int> >::iterator >&,/*Qit*/
+		const Eigen::MatrixXd&,/*C*/
+		const int e)->bool
+	{
+		return merge_quadrics(quadrics, e, F, E, EMAP, EF, EI);
+	};
+	post_collapse = [](
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const std::set<std::pair<double, int> >&,   /*Q*/
+		const std::vector<std::set<std::pair<double, int> >::iterator >&, /*Qit*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)->void {};
+}
+
+IGL_INLINE void igl::paper_quadric_collapse_edge_callbacks(
+	std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics,
+	std::function<void(
+		const int,
+		const Eigen::MatrixXd&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::VectorXi&,
+		const Eigen::MatrixXi&,
+		const Eigen::MatrixXi&,
+		double&,
+		Eigen::RowVectorXd&)>& cost_and_placement,
+	std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse)
+{
+	cost_and_placement = QuadricCost{ &quadrics };
+	pre_collapse = [&quadrics](
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI,
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int e)->bool
+	{
+		return merge_quadrics(quadrics, e, F, E, EMAP, EF, EI);
+	};
+	post_collapse = [](
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)->void {};
+}
@@ -0,0 +1,120 @@
+#ifndef IGL_PAPER_QUADRIC_COLLAPSE_EDGE_CALLBACKS_H
+#define IGL_PAPER_QUADRIC_COLLAPSE_EDGE_CALLBACKS_H
+#include "igl_inline.h"
+#include "IndexedMinHeap.h"
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+#include <functional>
+#include <vector>
+#include <set>
+namespace igl
+{
+    // Prepare callbacks for decimating edges with the cost and placement of
+    // paper_cost_and_new_vertex, but reading the end point quadrics from a
+    // persistent per-vertex store (see paper_vertex_quadrics) instead of
+    // rebuilding them from the one-rings for every evaluation. Evaluating an
+    // edge is O(1); when an edge is collapsed the surviving vertex gets
+    // Q = Q1 + Q2. The placement is solved in closed form, falling back to
+    // the midpoint or an end point where Q is singular (see
+    // quadric_cost_and_placement); paper_quadric_edge_costs computes the
+    // same for all edges at once.
+    //
+    // The merge is done in pre_collapse, after checking
+    // edge_collapse_is_valid, so the callbacks keep no state besides the
+    // quadrics themselves and collapse_edge is guaranteed to succeed once
+    // pre_collapse returned true.
+    //
+    // Inputs:
+    //   quadrics  reference to #V list of working per vertex quadrics
+    // Outputs:
+    //   cost_and_placement  callback for evaluating cost of edge collapse and
+    //     determining placement of vertex (see collapse_edge)
+    //   pre_collapse  callback before edge collapse (see collapse_edge)
+    //   post_collapse  callback after edge collapse (see collapse_edge)
+    IGL_INLINE void paper_quadric_collapse_edge_callbacks(
+        std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics,
+        std::function<void(
+            const int,
+            const Eigen::MatrixXd&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::VectorXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            double&,
+            Eigen::RowVectorXd&)>& cost_and_placement,
+        std::function<bool(
+            const Eigen::MatrixXd&,/*V*/
+            const Eigen::MatrixXi&,/*F*/
+            const Eigen::MatrixXi&,/*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,/*EF*/
+            const Eigen::MatrixXi&,/*EI*/
+            const std::set<std::pair<double, int> >&,/*Q*/
+            const std::vector<std::set<std::pair<double, int> >::iterator >&,/*Qit*/
+            const Eigen::MatrixXd&,/*C*/
+            const int                                                        /*e*/
+            )>& pre_collapse,
+        std::function<void(
+            const Eigen::MatrixXd&,   /*V*/
+            const Eigen::MatrixXi&,   /*F*/
+            const Eigen::MatrixXi&,   /*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,  /*EF*/
+            const Eigen::MatrixXi&,  /*EI*/
+            const std::set<std::pair<double, int> >&,   /*Q*/
+            const std::vector<std::set<std::pair<double, int> >::iterator >&, /*Qit*/
+            const Eigen::MatrixXd&,   /*C*/
+            const int,   /*e*/
+            const int,  /*e1*/
+            const int,  /*e2*/
+            const int,  /*f1*/
+            const int,  /*f2*/
+            const bool                                                  /*collapsed*/
+            )>& post_collapse);
+    // Same, for the IndexedMinHeap overloads of collapse_edge_new_impl
+    IGL_INLINE void paper_quadric_collapse_edge_callbacks(
+        std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics,
+        std::function<void(
+            const int,
+            const Eigen::MatrixXd&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::VectorXi&,
+            const Eigen::MatrixXi&,
+            const Eigen::MatrixXi&,
+            double&,
+            Eigen::RowVectorXd&)>& cost_and_placement,
+        std::function<bool(
+            const Eigen::MatrixXd&,/*V*/
+            const Eigen::MatrixXi&,/*F*/
+            const Eigen::MatrixXi&,/*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,/*EF*/
+            const Eigen::MatrixXi&,/*EI*/
+            const IndexedMinHeap&,/*Q*/
+            const Eigen::MatrixXd&,/*C*/
+            const int                                                        /*e*/
+            )>& pre_collapse,
+        std::function<void(
+            const Eigen::MatrixXd&,   /*V*/
+            const Eigen::MatrixXi&,   /*F*/
+            const Eigen::MatrixXi&,   /*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,  /*EF*/
+            const Eigen::MatrixXi&,  /*EI*/
+            const IndexedMinHeap&,   /*Q*/
+            const Eigen::MatrixXd&,   /*C*/
+            const int,   /*e*/
+            const int,  /*e1*/
+            const int,  /*e2*/
+            const int,  /*f1*/
+            const int,  /*f2*/
+            const bool                                                  /*collapsed*/
+            )>& post_collapse);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "paper_quadric_collapse_edge_callbacks.cpp"
+#endif
+#endif
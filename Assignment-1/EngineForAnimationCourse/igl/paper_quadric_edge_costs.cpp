@@ -0,0 +1,44 @@
+#include "paper_quadric_edge_costs.h"
+#include "quadric_cost_and_placement_batch.h"
+#include "parallel_for.h"
+#include <algorithm>
+
+IGL_INLINE void igl::paper_quadric_edge_costs(
+	const std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics,
+	const Eigen::MatrixXd& V,
+	const Eigen::MatrixXi& E,
+	Eigen::VectorXd& costs,
+	Eigen::MatrixXd& C,
+	const bool parallel)
+{
+	// Blocks small enough for their coefficients to stay in cache
+	const int block = 512;
+	const int num_edges = E.rows();
+	const int num_blocks = (num_edges + block - 1) / block;
+	costs.resize(num_edges);
+	C.resize(num_edges, 3);
+	const auto cost_block = [&](const int b)
+	{
+		const int begin = b * block;
+		const int n = std::min(block, num_edges - begin);
+		Eigen::Matrix<double, 10, Eigen::Dynamic, Eigen::RowMajor> Q(10, n);
+		Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> A(3, n), B(3, n), P;
+		Eigen::VectorXd cost;
+		for (int i = 0; i < n; i++)
+		{
+			const int e = begin + i;
+			const Eigen::Matrix4d q = quadrics[E(e, 0)] + quadrics[E(e, 1)];
+			Q.col(i) << q(0, 0), q(0, 1), q(0, 2), q(0, 3), q(1, 1), q(1, 2), q(1, 3), q(2, 2), q(2, 3), q(3, 3);
+			A.col(i) = V.row(E(e, 0)).transpose();
+			B.col(i) = V.row(E(e, 1)).transpose();
+		}
+		quadric_cost_and_placement_batch(Q, A, B, cost, P);
+		costs.segment(begin, n) = cost;
+		C.block(begin, 0, n, 3) = P.transpose();
+	};
+	if (parallel)
+		igl::parallel_for(num_blocks, cost_block, 4);
+	else
+		for (int b = 0; b < num_blocks; b++)
+			cost_block(b);
+}
@@ -0,0 +1,35 @@
+#ifndef IGL_PAPER_QUADRIC_EDGE_COSTS_H
+#define IGL_PAPER_QUADRIC_EDGE_COSTS_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+#include <vector>
+namespace igl
+{
+    // Initial costs and placements of all edges for the quadric callbacks
+    // (paper_quadric_collapse_edge_callbacks), computed in blocks of edges
+    // with quadric_cost_and_placement_batch, by default on all cores. Gives
+    // the same results as calling their cost_and_placement on every edge.
+    //
+    // Inputs:
+    //   quadrics  #V list of 4 by 4 vertex quadrics
+    //   V  #V by 3 list of vertex positions
+    //   E  #E by 2 list of edges
+    //   parallel  whether to spread the blocks over the cores, false when
+    //     the caller already keeps them busy (one mesh per thread)
+    // Outputs:
+    //   costs  #E costs
+    //   C  #E by 3 placements
+    IGL_INLINE void paper_quadric_edge_costs(
+        const std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics,
+        const Eigen::MatrixXd& V,
+        const Eigen::MatrixXi& E,
+        Eigen::VectorXd& costs,
+        Eigen::MatrixXd& C,
+        const bool parallel = true);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "paper_quadric_edge_costs.cpp"
+#endif
+#endif
@@ -0,0 +1,25 @@
+#include "paper_vertex_quadrics.h"
+#include <Eigen/Geometry>
+
+IGL_INLINE void igl::paper_vertex_quadrics(
+	const Eigen::MatrixXd& V,
+	const Eigen::MatrixXi& F,
+	std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics)
+{
+	quadrics.assign(V.rows(), Eigen::Matrix4d::Zero());
+	for (int f = 0; f < F.rows(); f++)
+	{
+		// collapsed faces are all IGL_COLLAPSE_EDGE_NULL
+		if (F(f, 0) == F(f, 1))
+			continue;
+		const Eigen::Vector3d v1 = V.row(F(f, 0));
+		const Eigen::Vector3d v2 = V.row(F(f, 1));
+		const Eigen::Vector3d v3 = V.row(F(f, 2));
+		const Eigen::Vector3d n = ((v2 - v1).cross(v3 - v1)).normalized();
+		Eigen::Vector4d p;
+		p << n, -n.dot(v1);
+		const Eigen::Matrix4d Kp = p * p.transpose();
+		for (int c = 0; c < 3; c++)
+			quadrics[F(f, c)] += Kp;
+	}
+}
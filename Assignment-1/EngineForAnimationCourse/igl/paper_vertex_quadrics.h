@@ -0,0 +1,29 @@
+#ifndef IGL_PAPER_VERTEX_QUADRICS_H
+#define IGL_PAPER_VERTEX_QUADRICS_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+#include <vector>
+namespace igl
+{
+    // Build the per-vertex error quadrics of the paper once for the whole
+    // mesh: every face contributes Kp = p*p' of its supporting plane
+    // p = [a b c d] (a^2+b^2+c^2 = 1) to each of its three corners, so that
+    // Q(v) is the sum of Kp over the faces around v. Previously collapsed
+    // faces ([IGL_COLLAPSE_EDGE_NULL ...]) are skipped.
+    //
+    // Inputs:
+    //   V  #V by 3 list of vertex positions
+    //   F  #F by 3 list of faces
+    // Outputs:
+    //   quadrics  #V list of 4 by 4 vertex quadrics
+    IGL_INLINE void paper_vertex_quadrics(
+        const Eigen::MatrixXd& V,
+        const Eigen::MatrixXi& F,
+        std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> >& quadrics);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "paper_vertex_quadrics.cpp"
+#endif
+#endif
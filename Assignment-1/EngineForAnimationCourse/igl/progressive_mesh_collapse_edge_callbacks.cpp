@@ -0,0 +1,143 @@
+#include "progressive_mesh_collapse_edge_callbacks.h"
+
+IGL_INLINE void igl::progressive_mesh_collapse_edge_callbacks(
+	ProgressiveMesh& pm,
+	std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const std::set<std::pair<double, int> >&,/*Q*/
+		const std::vector<std::set<std::pair<double, int> >::iterator >&,/*Qit*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const std::set<std::pair<double, int> >&,   /*Q*/
+		const std::vector<std::set<std::pair<double, int> >::iterator >&, /*Qit*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse)
+{
+	const auto inner_pre_collapse = pre_collapse;
+	const auto inner_post_collapse = post_collapse;
+	pre_collapse = [&pm, inner_pre_collapse](
+		const Eigen::MatrixXd& V,
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI,
+		const std::set<std::pair<double, int> >& Q,
+		const std::vector<std::set<std::pair<double, int> >::iterator >& Qit,
+		const Eigen::MatrixXd& C,
+		const int e)->bool
+	{
+		if (!inner_pre_collapse(V, F, E, EMAP, EF, EI, Q, Qit, C, e))
+			return false;
+		pm.begin_collapse(e, C.row(e), V, F, E, EMAP, EF, EI);
+		return true;
+	};
+	post_collapse = [&pm, inner_post_collapse](
+		const Eigen::MatrixXd& V,
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI,
+		const std::set<std::pair<double, int> >& Q,
+		const std::vector<std::set<std::pair<double, int> >::iterator >& Qit,
+		const Eigen::MatrixXd& C,
+		const int e,
+		const int e1,
+		const int e2,
+		const int f1,
+		const int f2,
+		const bool collapsed)->void
+	{
+		pm.end_collapse(e, collapsed);
+		inner_post_collapse(V, F, E, EMAP, EF, EI, Q, Qit, C, e, e1, e2, f1, f2, collapsed);
+	};
+}
+
+IGL_INLINE void igl::progressive_mesh_collapse_edge_callbacks(
+	ProgressiveMesh& pm,
+	std::function<bool(
+		const Eigen::MatrixXd&,/*V*/
+		const Eigen::MatrixXi&,/*F*/
+		const Eigen::MatrixXi&,/*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,/*EF*/
+		const Eigen::MatrixXi&,/*EI*/
+		const IndexedMinHeap&,/*Q*/
+		const Eigen::MatrixXd&,/*C*/
+		const int                                                        /*e*/
+		)>& pre_collapse,
+	std::function<void(
+		const Eigen::MatrixXd&,   /*V*/
+		const Eigen::MatrixXi&,   /*F*/
+		const Eigen::MatrixXi&,   /*E*/
+		const Eigen::VectorXi&,/*EMAP*/
+		const Eigen::MatrixXi&,  /*EF*/
+		const Eigen::MatrixXi&,  /*EI*/
+		const IndexedMinHeap&,   /*Q*/
+		const Eigen::MatrixXd&,   /*C*/
+		const int,   /*e*/
+		const int,  /*e1*/
+		const int,  /*e2*/
+		const int,  /*f1*/
+		const int,  /*f2*/
+		const bool                                                  /*collapsed*/
+		)>& post_collapse)
+{
+	const auto inner_pre_collapse = pre_collapse;
+	const auto inner_post_collapse = post_collapse;
+	pre_collapse = [&pm, inner_pre_collapse](
+		const Eigen::MatrixXd& V,
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI,
+		const IndexedMinHeap& Q,
+		const Eigen::MatrixXd& C,
+		const int e)->bool
+	{
+		if (!inner_pre_collapse(V, F, E, EMAP, EF, EI, Q, C, e))
+			return false;
+		pm.begin_collapse(e, C.row(e), V, F, E, EMAP, EF, EI);
+		return true;
+	};
+	post_collapse = [&pm, inner_post_collapse](
+		const Eigen::MatrixXd& V,
+		const Eigen::MatrixXi& F,
+		const Eigen::MatrixXi& E,
+		const Eigen::VectorXi& EMAP,
+		const Eigen::MatrixXi& EF,
+		const Eigen::MatrixXi& EI,
+		const IndexedMinHeap& Q,
+		const Eigen::MatrixXd& C,
+		const int e,
+		const int e1,
+		const int e2,
+		const int f1,
+		const int f2,
+		const bool collapsed)->void
+	{
+		pm.end_collapse(e, collapsed);
+		inner_post_collapse(V, F, E, EMAP, EF, EI, Q, C, e, e1, e2, f1, f2, collapsed);
+	};
+}
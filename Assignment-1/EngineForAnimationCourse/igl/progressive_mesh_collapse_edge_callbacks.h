@@ -0,0 +1,88 @@
+#ifndef IGL_PROGRESSIVE_MESH_COLLAPSE_EDGE_CALLBACKS_H
+#define IGL_PROGRESSIVE_MESH_COLLAPSE_EDGE_CALLBACKS_H
+#include "igl_inline.h"
+#include "IndexedMinHeap.h"
+#include "ProgressiveMesh.h"
+#include <Eigen/Core>
+#include <functional>
+#include <vector>
+#include <set>
+namespace igl
+{
+    // Wrap a pair of collapse callbacks so that every collapse they let
+    // through is also recorded into a progressive mesh log: the collapse is
+    // begun after pre_collapse accepted it and ended in post_collapse.
+    //
+    // Inputs:
+    //   pm  progressive mesh log to record into (kept by reference)
+    //   pre_collapse  callback before edge collapse (see collapse_edge)
+    //   post_collapse  callback after edge collapse (see collapse_edge)
+    // Outputs:
+    //   pre_collapse, post_collapse  the same callbacks, recording into pm
+    IGL_INLINE void progressive_mesh_collapse_edge_callbacks(
+        ProgressiveMesh& pm,
+        std::function<bool(
+            const Eigen::MatrixXd&,/*V*/
+            const Eigen::MatrixXi&,/*F*/
+            const Eigen::MatrixXi&,/*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,/*EF*/
+            const Eigen::MatrixXi&,/*EI*/
+            const std::set<std::pair<double, int> >&,/*Q*/
+            const std::vector<std::set<std::pair<double, int> >::iterator >&,/*Qit*/
+            const Eigen::MatrixXd&,/*C*/
+            const int                                                        /*e*/
+            )>& pre_collapse,
+        std::function<void(
+            const Eigen::MatrixXd&,   /*V*/
+            const Eigen::MatrixXi&,   /*F*/
+            const Eigen::MatrixXi&,   /*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,  /*EF*/
+            const Eigen::MatrixXi&,  /*EI*/
+            const std::set<std::pair<double, int> >&,   /*Q*/
+            const std::vector<std::set<std::pair<double, int> >::iterator >&, /*Qit*/
+            const Eigen::MatrixXd&,   /*C*/
+            const int,   /*e*/
+            const int,  /*e1*/
+            const int,  /*e2*/
+            const int,  /*f1*/
+            const int,  /*f2*/
+            const bool                                                  /*collapsed*/
+            )>& post_collapse);
+    // Same, for the IndexedMinHeap overloads of collapse_edge_new_impl
+    IGL_INLINE void progressive_mesh_collapse_edge_callbacks(
+        ProgressiveMesh& pm,
+        std::function<bool(
+            const Eigen::MatrixXd&,/*V*/
+            const Eigen::MatrixXi&,/*F*/
+            const Eigen::MatrixXi&,/*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,/*EF*/
+            const Eigen::MatrixXi&,/*EI*/
+            const IndexedMinHeap&,/*Q*/
+            const Eigen::MatrixXd&,/*C*/
+            const int                                                        /*e*/
+            )>& pre_collapse,
+        std::function<void(
+            const Eigen::MatrixXd&,   /*V*/
+            const Eigen::MatrixXi&,   /*F*/
+            const Eigen::MatrixXi&,   /*E*/
+            const Eigen::VectorXi&,/*EMAP*/
+            const Eigen::MatrixXi&,  /*EF*/
+            const Eigen::MatrixXi&,  /*EI*/
+            const IndexedMinHeap&,   /*Q*/
+            const Eigen::MatrixXd&,   /*C*/
+            const int,   /*e*/
+            const int,  /*e1*/
+            const int,  /*e2*/
+            const int,  /*f1*/
+            const int,  /*f2*/
+            const bool                                                  /*collapsed*/
+            )>& post_collapse);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "progressive_mesh_collapse_edge_callbacks.cpp"
+#endif
+#endif
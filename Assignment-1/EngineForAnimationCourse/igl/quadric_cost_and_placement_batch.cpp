@@ -0,0 +1,196 @@
+#include "quadric_cost_and_placement_batch.h"
+#include <cmath>
+#include <limits>
+#if defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define IGL_QUADRIC_BATCH_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace
+{
+	// A is taken as singular when det(A) <= tol * trace(A)^3, i.e. when its
+	// smallest eigenvalue is about 1e-9 of the others or less
+	const double singular_tolerance = 1e-10;
+
+	// Same arithmetic on 1, 2 or 4 lanes
+	struct ScalarPack
+	{
+		typedef double T;
+		static const int width = 1;
+		static T load(const double* x) { return *x; }
+		static void store(double* x, const T a) { *x = a; }
+		static T set(const double a) { return a; }
+		static T add(const T a, const T b) { return a + b; }
+		static T sub(const T a, const T b) { return a - b; }
+		static T mul(const T a, const T b) { return a * b; }
+		static T div(const T a, const T b) { return a / b; }
+		static T abs(const T a) { return std::abs(a); }
+		// bit i set iff lane i has a > b and finite c
+		static int ok(const T a, const T b, const T c) { return a > b && c - c == 0; }
+	};
+#if defined(__AVX__)
+	struct SimdPack
+	{
+		typedef __m256d T;
+		static const int width = 4;
+		static T load(const double* x) { return _mm256_loadu_pd(x); }
+		static void store(double* x, const T a) { _mm256_storeu_pd(x, a); }
+		static T set(const double a) { return _mm256_set1_pd(a); }
+		static T add(const T a, const T b) { return _mm256_add_pd(a, b); }
+		static T sub(const T a, const T b) { return _mm256_sub_pd(a, b); }
+		static T mul(const T a, const T b) { return _mm256_mul_pd(a, b); }
+		static T div(const T a, const T b) { return _mm256_div_pd(a, b); }
+		static T abs(const T a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+		static int ok(const T a, const T b, const T c)
+		{
+			const T finite = _mm256_cmp_pd(_mm256_sub_pd(c, c), _mm256_setzero_pd(), _CMP_EQ_OQ);
+			return _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ), finite));
+		}
+	};
+#elif defined(IGL_QUADRIC_BATCH_SSE2)
+	struct SimdPack
+	{
+		typedef __m128d T;
+		static const int width = 2;
+		static T load(const double* x) { return _mm_loadu_pd(x); }
+		static void store(double* x, const T a) { _mm_storeu_pd(x, a); }
+		static T set(const double a) { return _mm_set1_pd(a); }
+		static T add(const T a, const T b) { return _mm_add_pd(a, b); }
+		static T sub(const T a, const T b) { return _mm_sub_pd(a, b); }
+		static T mul(const T a, const T b) { return _mm_mul_pd(a, b); }
+		static T div(const T a, const T b) { return _mm_div_pd(a, b); }
+		static T abs(const T a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+		static int ok(const T a, const T b, const T c)
+		{
+			const T finite = _mm_cmpeq_pd(_mm_sub_pd(c, c), _mm_setzero_pd());
+			return _mm_movemask_pd(_mm_and_pd(_mm_cmpgt_pd(a, b), finite));
+		}
+	};
+#endif
+
+	// [p 1] Q [p 1]' for the quadric in column i of the 10 by n Q
+	double evaluate(const double* Q, const int n, const int i, const double x, const double y, const double z)
+	{
+		const double* q = Q + i;
+		return
+			q[0 * n] * x * x + q[4 * n] * y * y + q[7 * n] * z * z +
+			2 * (q[1 * n] * x * y + q[2 * n] * x * z + q[5 * n] * y * z) +
+			2 * (q[3 * n] * x + q[6 * n] * y + q[8 * n] * z) +
+			q[9 * n];
+	}
+
+	// Closed form solve of edges [begin, end) in packs of Pack::width lanes.
+	// Lanes where A is singular are fixed up with the midpoint/end point
+	// fallback. Returns the first edge not handled (end - begin is not
+	// necessarily a multiple of the width).
+	template <typename Pack>
+	int solve(const int begin, const int end, const int n, const double* Q, const double* A, const double* B, double* cost, double* P)
+	{
+		typedef typename Pack::T T;
+		int i = begin;
+		for (; i + Pack::width <= end; i += Pack::width)
+		{
+			const T a00 = Pack::load(Q + 0 * n + i);
+			const T a01 = Pack::load(Q + 1 * n + i);
+			const T a02 = Pack::load(Q + 2 * n + i);
+			const T b0 = Pack::load(Q + 3 * n + i);
+			const T a11 = Pack::load(Q + 4 * n + i);
+			const T a12 = Pack::load(Q + 5 * n + i);
+			const T b1 = Pack::load(Q + 6 * n + i);
+			const T a22 = Pack::load(Q + 7 * n + i);
+			const T b2 = Pack::load(Q + 8 * n + i);
+			const T c = Pack::load(Q + 9 * n + i);
+			// Cofactors of the symmetric A
+			const T c00 = Pack::sub(Pack::mul(a11, a22), Pack::mul(a12, a12));
+			const T c01 = Pack::sub(Pack::mul(a02, a12), Pack::mul(a01, a22));
+			const T c02 = Pack::sub(Pack::mul(a01, a12), Pack::mul(a02, a11));
+			const T c11 = Pack::sub(Pack::mul(a00, a22), Pack::mul(a02, a02));
+			const T c12 = Pack::sub(Pack::mul(a01, a02), Pack::mul(a00, a12));
+			const T c22 = Pack::sub(Pack::mul(a00, a11), Pack::mul(a01, a01));
+			const T det = Pack::add(Pack::add(Pack::mul(a00, c00), Pack::mul(a01, c01)), Pack::mul(a02, c02));
+			// p = -A^-1 b = -adj(A) b / det
+			const T minus_inv_det = Pack::div(Pack::set(-1.0), det);
+			const T x = Pack::mul(Pack::add(Pack::add(Pack::mul(c00, b0), Pack::mul(c01, b1)), Pack::mul(c02, b2)), minus_inv_det);
+			const T y = Pack::mul(Pack::add(Pack::add(Pack::mul(c01, b0), Pack::mul(c11, b1)), Pack::mul(c12, b2)), minus_inv_det);
+			const T z = Pack::mul(Pack::add(Pack::add(Pack::mul(c02, b0), Pack::mul(c12, b1)), Pack::mul(c22, b2)), minus_inv_det);
+			// At the minimum [p 1] Q [p 1]' reduces to c + b.p
+			const T e = Pack::add(c, Pack::add(Pack::add(Pack::mul(b0, x), Pack::mul(b1, y)), Pack::mul(b2, z)));
+			Pack::store(P + 0 * n + i, x);
+			Pack::store(P + 1 * n + i, y);
+			Pack::store(P + 2 * n + i, z);
+			Pack::store(cost + i, e);
+
+			const T trace = Pack::add(Pack::add(a00, a11), a22);
+			const T limit = Pack::mul(Pack::set(singular_tolerance), Pack::mul(trace, Pack::mul(trace, trace)));
+			const int ok = Pack::ok(Pack::abs(det), limit, e);
+			if (ok == (1 << Pack::width) - 1)
+				continue;
+			for (int l = 0; l < Pack::width; l++)
+			{
+				if (ok & (1 << l))
+					continue;
+				// Singular: keep the best of the midpoint and the end points
+				const int j = i + l;
+				const double candidates[3][3] = {
+					{ 0.5 * (A[j] + B[j]), 0.5 * (A[n + j] + B[n + j]), 0.5 * (A[2 * n + j] + B[2 * n + j]) },
+					{ A[j], A[n + j], A[2 * n + j] },
+					{ B[j], B[n + j], B[2 * n + j] } };
+				cost[j] = std::numeric_limits<double>::infinity();
+				for (const auto& candidate : candidates)
+				{
+					const double candidate_cost = evaluate(Q, n, j, candidate[0], candidate[1], candidate[2]);
+					if (candidate_cost < cost[j])
+					{
+						cost[j] = candidate_cost;
+						P[j] = candidate[0];
+						P[n + j] = candidate[1];
+						P[2 * n + j] = candidate[2];
+					}
+				}
+				if (!(cost[j] < std::numeric_limits<double>::infinity()))
+				{
+					// Force infs and nans to infinity
+					cost[j] = std::numeric_limits<double>::infinity();
+					P[j] = P[n + j] = P[2 * n + j] = 0;
+				}
+			}
+		}
+		return i;
+	}
+}
+
+IGL_INLINE void igl::quadric_cost_and_placement_batch(
+	const Eigen::Matrix<double, 10, Eigen::Dynamic, Eigen::RowMajor>& Q,
+	const Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>& A,
+	const Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>& B,
+	Eigen::VectorXd& cost,
+	Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>& P)
+{
+	const int n = Q.cols();
+	cost.resize(n);
+	P.resize(3, n);
+	int i = 0;
+#if defined(__AVX__) || defined(IGL_QUADRIC_BATCH_SSE2)
+	i = solve<SimdPack>(i, n, n, Q.data(), A.data(), B.data(), cost.data(), P.data());
+#endif
+	solve<ScalarPack>(i, n, n, Q.data(), A.data(), B.data(), cost.data(), P.data());
+}
+
+IGL_INLINE void igl::quadric_cost_and_placement(
+	const Eigen::Matrix4d& Q,
+	const Eigen::RowVector3d& a,
+	const Eigen::RowVector3d& b,
+	double& cost,
+	Eigen::RowVector3d& p)
+{
+	const double q[10] = { Q(0, 0), Q(0, 1), Q(0, 2), Q(0, 3), Q(1, 1), Q(1, 2), Q(1, 3), Q(2, 2), Q(2, 3), Q(3, 3) };
+	double P[3];
+	solve<ScalarPack>(0, 1, 1, q, a.data(), b.data(), &cost, P);
+	p << P[0], P[1], P[2];
+}
+
+#ifdef IGL_QUADRIC_BATCH_SSE2
+#  undef IGL_QUADRIC_BATCH_SSE2
+#endif
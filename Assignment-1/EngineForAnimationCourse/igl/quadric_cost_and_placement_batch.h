@@ -0,0 +1,51 @@
+#ifndef IGL_QUADRIC_COST_AND_PLACEMENT_BATCH_H
+#define IGL_QUADRIC_COST_AND_PLACEMENT_BATCH_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+    // Optimal placements and costs for many edge quadrics at once. Each
+    // quadric Q = [A b; b' c] is minimized in closed form, p = -A^-1 b with
+    // the 3 by 3 inverse from cofactors, and costs c + b.p. When A is
+    // (nearly) singular, e.g. for flat or creased neighbourhoods, p is
+    // instead the best of the midpoint and the two end points of the edge.
+    //
+    // Data are laid out as structure of arrays (one row per coefficient) so
+    // that 4 edges are solved per AVX instruction, or 2 with SSE2; the
+    // widest instruction set enabled at compile time is used, and a plain
+    // scalar loop otherwise and for the remainder.
+    //
+    // Inputs:
+    //   Q  10 by #E unique coefficients of the symmetric 4 by 4 quadrics, in
+    //     the order q00 q01 q02 q03 q11 q12 q13 q22 q23 q33
+    //   A  3 by #E first end points
+    //   B  3 by #E second end points
+    // Outputs:
+    //   cost  #E costs
+    //   P  3 by #E placements
+    IGL_INLINE void quadric_cost_and_placement_batch(
+        const Eigen::Matrix<double, 10, Eigen::Dynamic, Eigen::RowMajor>& Q,
+        const Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>& A,
+        const Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>& B,
+        Eigen::VectorXd& cost,
+        Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor>& P);
+    // Same for a single edge, with the same scalar code
+    //
+    // Inputs:
+    //   Q  4 by 4 symmetric quadric
+    //   a, b  end points of the edge
+    // Outputs:
+    //   cost  cost of p
+    //   p  placement
+    IGL_INLINE void quadric_cost_and_placement(
+        const Eigen::Matrix4d& Q,
+        const Eigen::RowVector3d& a,
+        const Eigen::RowVector3d& b,
+        double& cost,
+        Eigen::RowVector3d& p);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "quadric_cost_and_placement_batch.cpp"
+#endif
+#endif
@@ -0,0 +1,656 @@
+#include "streaming_vertex_clustering.h"
+#include "quadric_cost_and_placement_batch.h"
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	typedef std::uint64_t CellId;
+
+	bool seek_file(FILE* file, const std::int64_t offset)
+	{
+#ifdef _WIN32
+		return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+		return fseeko(file, offset, SEEK_SET) == 0;
+#endif
+	}
+
+	// Reads a text file line by line through a fixed size buffer
+	class LineReader
+	{
+	public:
+		LineReader(FILE* a_file, const std::size_t chunk) : file(a_file), buffer(chunk), begin(0), end(0), eof(false) {}
+		// Next line, without its '\n', in [line, line_end). Returns false at
+		// the end of the file.
+		bool next(const char*& line, const char*& line_end)
+		{
+			while (true)
+			{
+				const char* newline = (const char*)std::memchr(buffer.data() + begin, '\n', end - begin);
+				if (newline)
+				{
+					line = buffer.data() + begin;
+					line_end = newline;
+					begin = newline - buffer.data() + 1;
+					return true;
+				}
+				if (eof)
+				{
+					if (begin == end)
+						return false;
+					line = buffer.data() + begin;
+					line_end = buffer.data() + end;
+					begin = end;
+					return true;
+				}
+				// Move the partial line to the front and refill behind it
+				std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+				end -= begin;
+				begin = 0;
+				if (end == buffer.size())
+					buffer.resize(2 * buffer.size());
+				const std::size_t n = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+				end += n;
+				eof = n == 0;
+			}
+		}
+	private:
+		FILE* file;
+		std::vector<char> buffer;
+		std::size_t begin, end;
+		bool eof;
+	};
+
+	void skip_space(const char*& s, const char* end)
+	{
+		while (s < end && (*s == ' ' || *s == '\t' || *s == '\r'))
+			s++;
+	}
+
+	// Plain decimal/exponent parser, much faster than strtod and precise
+	// enough for positions that are stored as floats anyway
+	bool parse_double(const char*& s, const char* end, double& x)
+	{
+		skip_space(s, end);
+		const char* start = s;
+		bool negative = false;
+		if (s < end && (*s == '-' || *s == '+'))
+			negative = *s++ == '-';
+		double mantissa = 0;
+		int exponent = 0;
+		bool digits = false;
+		for (; s < end && *s >= '0' && *s <= '9'; s++, digits = true)
+			mantissa = 10 * mantissa + (*s - '0');
+		if (s < end && *s == '.')
+		{
+			for (s++; s < end && *s >= '0' && *s <= '9'; s++, digits = true)
+			{
+				mantissa = 10 * mantissa + (*s - '0');
+				exponent--;
+			}
+		}
+		if (!digits)
+		{
+			s = start;
+			return false;
+		}
+		if (s < end && (*s == 'e' || *s == 'E'))
+		{
+			s++;
+			bool negative_exponent = false;
+			if (s < end && (*s == '-' || *s == '+'))
+				negative_exponent = *s++ == '-';
+			int e = 0;
+			for (; s < end && *s >= '0' && *s <= '9'; s++)
+				e = std::min(10 * e + (*s - '0'), 10000);
+			exponent += negative_exponent ? -e : e;
+		}
+		x = exponent < 0 ? mantissa / std::pow(10.0, -exponent) : mantissa * std::pow(10.0, exponent);
+		if (negative)
+			x = -x;
+		return true;
+	}
+
+	// Integer followed by anything up to the next space (e.g. "/2/3" of
+	// obj faces)
+	bool parse_index(const char*& s, const char* end, std::int64_t& i)
+	{
+		skip_space(s, end);
+		bool negative = false;
+		if (s < end && (*s == '-' || *s == '+'))
+			negative = *s++ == '-';
+		if (s == end || *s < '0' || *s > '9')
+			return false;
+		for (i = 0; s < end && *s >= '0' && *s <= '9'; s++)
+			i = 10 * i + (*s - '0');
+		if (negative)
+			i = -i;
+		while (s < end && *s != ' ' && *s != '\t' && *s != '\r')
+			s++;
+		return true;
+	}
+
+	// Triangle soup on disk: float x y z per vertex, int32 triples per face
+	struct Soup
+	{
+		FILE* vertices = nullptr;
+		FILE* faces = nullptr;
+		std::int64_t num_vertices = 0;
+		std::int64_t num_faces = 0;
+		Eigen::AlignedBox3d box;
+		std::vector<float> vertex_buffer;
+		std::vector<std::int32_t> face_buffer;
+		bool ok = true;
+
+		~Soup()
+		{
+			if (vertices)
+				std::fclose(vertices);
+			if (faces)
+				std::fclose(faces);
+		}
+		void add_vertex(const double x, const double y, const double z)
+		{
+			box.extend(Eigen::Vector3d(x, y, z));
+			vertex_buffer.push_back((float)x);
+			vertex_buffer.push_back((float)y);
+			vertex_buffer.push_back((float)z);
+			num_vertices++;
+			if (vertex_buffer.size() >= 3 * 65536)
+				flush();
+		}
+		// Fan triangulation of a polygon given by 0-based indices
+		void add_polygon(const std::vector<std::int64_t>& polygon)
+		{
+			for (std::size_t k = 2; k < polygon.size(); k++)
+			{
+				for (const std::int64_t i : { polygon[0], polygon[k - 1], polygon[k] })
+				{
+					if (i < 0 || i > std::numeric_limits<std::int32_t>::max())
+					{
+						ok = false;
+						return;
+					}
+					face_buffer.push_back((std::int32_t)i);
+				}
+				num_faces++;
+			}
+			if (face_buffer.size() >= 3 * 65536)
+				flush();
+		}
+		void flush()
+		{
+			ok = ok &&
+				std::fwrite(vertex_buffer.data(), sizeof(float), vertex_buffer.size(), vertices) == vertex_buffer.size() &&
+				std::fwrite(face_buffer.data(), sizeof(std::int32_t), face_buffer.size(), faces) == face_buffer.size();
+			vertex_buffer.clear();
+			face_buffer.clear();
+		}
+	};
+
+	bool read_obj(LineReader& reader, Soup& soup)
+	{
+		const char* s;
+		const char* end;
+		std::vector<std::int64_t> polygon;
+		while (soup.ok && reader.next(s, end))
+		{
+			skip_space(s, end);
+			if (end - s < 2 || (s[1] != ' ' && s[1] != '\t'))
+				continue;
+			if (s[0] == 'v')
+			{
+				s += 2;
+				double x, y, z;
+				if (!parse_double(s, end, x) || !parse_double(s, end, y) || !parse_double(s, end, z))
+					return false;
+				soup.add_vertex(x, y, z);
+			}
+			else if (s[0] == 'f')
+			{
+				s += 2;
+				polygon.clear();
+				std::int64_t i;
+				while (parse_index(s, end, i))
+				{
+					// 1-based, or relative to the last vertex when negative
+					polygon.push_back(i < 0 ? soup.num_vertices + i : i - 1);
+				}
+				soup.add_polygon(polygon);
+			}
+		}
+		return soup.ok;
+	}
+
+	bool read_off(LineReader& reader, Soup& soup)
+	{
+		const char* s;
+		const char* end;
+		// Header keyword (OFF, COFF, NOFF, ...), possibly followed by the
+		// counts on the same line
+		std::int64_t counts[3];
+		int num_counts = 0;
+		bool header = false;
+		while (num_counts < 2 && reader.next(s, end))
+		{
+			skip_space(s, end);
+			if (s == end || *s == '#')
+				continue;
+			if (!header)
+			{
+				const char* keyword = s;
+				while (s < end && *s != ' ' && *s != '\t' && *s != '\r')
+					s++;
+				if (s - keyword < 3 || std::strncmp(s - 3, "OFF", 3) != 0)
+					return false;
+				header = true;
+			}
+			std::int64_t i;
+			while (num_counts < 3 && parse_index(s, end, i))
+				counts[num_counts++] = i;
+		}
+		if (num_counts < 2)
+			return false;
+		std::vector<std::int64_t> polygon;
+		std::int64_t faces_read = 0;
+		// The vertices come first, and there may be no faces after them
+		while (soup.ok && (soup.num_vertices < counts[0] || faces_read < counts[1]) && reader.next(s, end))
+		{
+			skip_space(s, end);
+			if (s == end || *s == '#')
+				continue;
+			if (soup.num_vertices < counts[0])
+			{
+				double x, y, z;
+				if (!parse_double(s, end, x) || !parse_double(s, end, y) || !parse_double(s, end, z))
+					return false;
+				soup.add_vertex(x, y, z);
+				continue;
+			}
+			std::int64_t n, i;
+			if (!parse_index(s, end, n))
+				return false;
+			polygon.clear();
+			for (std::int64_t k = 0; k < n; k++)
+			{
+				if (!parse_index(s, end, i))
+					return false;
+				polygon.push_back(i);
+			}
+			soup.add_polygon(polygon);
+			faces_read++;
+		}
+		return soup.ok && soup.num_vertices == counts[0] && faces_read == counts[1];
+	}
+
+	// LRU cache of fixed size pages of the vertex file
+	class VertexCache
+	{
+	public:
+		VertexCache(FILE* a_file, const std::int64_t a_num_vertices, const std::size_t memory) :
+			ok(true),
+			file(a_file),
+			num_vertices(a_num_vertices),
+			page_slot((a_num_vertices + page_size - 1) / page_size, -1),
+			tick(0)
+		{
+			const std::size_t page_bytes = 3 * sizeof(float) * page_size;
+			const std::size_t num_slots = std::max<std::size_t>(1, std::min(page_slot.size(), memory / page_bytes));
+			slots.resize(num_slots);
+			slot_page.assign(num_slots, -1);
+			slot_used.assign(num_slots, 0);
+		}
+		// Copies the position of vertex v to p
+		void get(const std::int64_t v, double* p)
+		{
+			const std::int64_t page = v / page_size;
+			int slot = page_slot[page];
+			if (slot < 0)
+			{
+				slot = (int)(std::min_element(slot_used.begin(), slot_used.end()) - slot_used.begin());
+				if (slot_page[slot] >= 0)
+					page_slot[slot_page[slot]] = -1;
+				const std::size_t n = (std::size_t)(3 * std::min(page_size, num_vertices - page * page_size));
+				slots[slot].resize(n);
+				ok = ok &&
+					seek_file(file, page * page_size * 3 * (std::int64_t)sizeof(float)) &&
+					std::fread(slots[slot].data(), sizeof(float), n, file) == n;
+				slot_page[slot] = page;
+				page_slot[page] = slot;
+			}
+			slot_used[slot] = ++tick;
+			const float* q = slots[slot].data() + 3 * (v - page * page_size);
+			p[0] = q[0];
+			p[1] = q[1];
+			p[2] = q[2];
+		}
+		// False after a failed read
+		bool ok;
+	private:
+		static const std::int64_t page_size = 1 << 16;
+		FILE* file;
+		std::int64_t num_vertices;
+		std::vector<int> page_slot;
+		std::vector<std::vector<float> > slots;
+		std::vector<std::int64_t> slot_page;
+		std::vector<std::uint64_t> slot_used;
+		std::uint64_t tick;
+	};
+
+	struct Cell
+	{
+		// q00 q01 q02 q03 q11 q12 q13 q22 q23 q33, as for
+		// quadric_cost_and_placement_batch
+		double q[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		double sum[3] = { 0, 0, 0 };
+		int count = 0;
+		int index = -1;
+	};
+
+	// Output face as cluster ids; equal (and hashed alike) to the same
+	// clusters in any order
+	struct Triangle
+	{
+		CellId c[3];
+	};
+	struct TriangleKey
+	{
+		static void sorted(const Triangle& t, CellId* s)
+		{
+			s[0] = t.c[0];
+			s[1] = t.c[1];
+			s[2] = t.c[2];
+			if (s[0] > s[1]) std::swap(s[0], s[1]);
+			if (s[1] > s[2]) std::swap(s[1], s[2]);
+			if (s[0] > s[1]) std::swap(s[0], s[1]);
+		}
+		std::size_t operator()(const Triangle& t) const
+		{
+			CellId s[3];
+			sorted(t, s);
+			return (std::size_t)((s[0] * 73856093u) ^ (s[1] * 19349663u) ^ (s[2] * 83492791u));
+		}
+		bool operator()(const Triangle& a, const Triangle& b) const
+		{
+			CellId s[3], t[3];
+			sorted(a, s);
+			sorted(b, t);
+			return s[0] == t[0] && s[1] == t[1] && s[2] == t[2];
+		}
+	};
+
+	// Regular grid with cells of size h * 2^level, level being raised as
+	// memory runs short
+	struct Grid
+	{
+		Eigen::Vector3d origin;
+		double h;
+		std::int64_t dims[3];
+		int level = 0;
+
+		std::int64_t dim(const int k, const int at_level) const { return ((dims[k] - 1) >> at_level) + 1; }
+		CellId encode(const std::int64_t* i, const int at_level) const
+		{
+			return (CellId)(i[0] + dim(0, at_level) * (i[1] + dim(1, at_level) * i[2]));
+		}
+		void decode(CellId id, const int at_level, std::int64_t* i) const
+		{
+			i[0] = id % dim(0, at_level);
+			id /= dim(0, at_level);
+			i[1] = id % dim(1, at_level);
+			i[2] = id / dim(1, at_level);
+		}
+		CellId cell(const double* p) const
+		{
+			std::int64_t i[3];
+			for (int k = 0; k < 3; k++)
+			{
+				const double x = std::floor((p[k] - origin(k)) / h);
+				i[k] = std::max<std::int64_t>(0, std::min<std::int64_t>(dims[k] - 1, (std::int64_t)x)) >> level;
+			}
+			return encode(i, level);
+		}
+		CellId coarser(const CellId id) const
+		{
+			std::int64_t i[3];
+			decode(id, level - 1, i);
+			for (int k = 0; k < 3; k++)
+				i[k] >>= 1;
+			return encode(i, level);
+		}
+	};
+
+	typedef std::unordered_map<CellId, Cell> Cells;
+	typedef std::unordered_set<Triangle, TriangleKey, TriangleKey> Triangles;
+	const std::size_t cell_bytes = sizeof(Cell) + sizeof(CellId) + 4 * sizeof(void*);
+	const std::size_t triangle_bytes = sizeof(Triangle) + 4 * sizeof(void*);
+
+	// Coarsen the grid by 2 until the clusters fit in memory again
+	void coarsen_to_fit(const std::size_t memory, Grid& grid, Cells& cells, Triangles& triangles)
+	{
+		while (cells.size() * cell_bytes + triangles.size() * triangle_bytes > memory && cells.size() > 1)
+		{
+			grid.level++;
+			Cells coarse_cells;
+			for (const auto& entry : cells)
+			{
+				Cell& cell = coarse_cells[grid.coarser(entry.first)];
+				for (int k = 0; k < 10; k++)
+					cell.q[k] += entry.second.q[k];
+				for (int k = 0; k < 3; k++)
+					cell.sum[k] += entry.second.sum[k];
+				cell.count += entry.second.count;
+			}
+			cells.swap(coarse_cells);
+			coarse_cells.clear();
+			Triangles coarse_triangles;
+			for (const Triangle& t : triangles)
+			{
+				const Triangle c = { { grid.coarser(t.c[0]), grid.coarser(t.c[1]), grid.coarser(t.c[2]) } };
+				if (c.c[0] != c.c[1] && c.c[1] != c.c[2] && c.c[2] != c.c[0])
+					coarse_triangles.insert(c);
+			}
+			triangles.swap(coarse_triangles);
+		}
+	}
+}
+
+IGL_INLINE bool igl::streaming_vertex_clustering(
+	const std::string& filename,
+	const std::size_t max_memory,
+	int& resolution,
+	Eigen::MatrixXd& V,
+	Eigen::MatrixXi& F)
+{
+	// Split of the memory: read buffer, vertex pages, cells and faces
+	const std::size_t chunk = std::max<std::size_t>(1 << 16, std::min<std::size_t>(1 << 24, max_memory / 16));
+	const std::size_t vertex_memory = max_memory / 4;
+	const std::size_t cluster_memory = max_memory > chunk + vertex_memory ? max_memory - chunk - vertex_memory : 0;
+
+	// Parse into the binary soup
+	Soup soup;
+	{
+		FILE* file = std::fopen(filename.c_str(), "rb");
+		if (!file)
+		{
+			std::cerr << "streaming_vertex_clustering: can't open " << filename << std::endl;
+			return false;
+		}
+		soup.vertices = std::tmpfile();
+		soup.faces = std::tmpfile();
+		const std::size_t dot = filename.find_last_of('.');
+		std::string ext = dot == std::string::npos ? "" : filename.substr(dot + 1);
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		LineReader reader(file, chunk);
+		bool read = false;
+		if (!soup.vertices || !soup.faces)
+			std::cerr << "streaming_vertex_clustering: can't create temporary files" << std::endl;
+		else if (ext == "obj")
+			read = read_obj(reader, soup);
+		else if (ext == "off")
+			read = read_off(reader, soup);
+		else
+			std::cerr << "streaming_vertex_clustering: unsupported extension " << ext << std::endl;
+		std::fclose(file);
+		soup.flush();
+		if (!read || !soup.ok)
+		{
+			std::cerr << "streaming_vertex_clustering: can't read " << filename << std::endl;
+			return false;
+		}
+		if (soup.num_vertices == 0)
+		{
+			std::cerr << "streaming_vertex_clustering: no vertices in " << filename << std::endl;
+			return false;
+		}
+	}
+
+	Grid grid;
+	resolution = std::max(1, std::min(resolution, 1 << 20));
+	const Eigen::Vector3d extent = soup.box.sizes();
+	grid.origin = soup.box.min();
+	grid.h = extent.maxCoeff() > 0 ? extent.maxCoeff() / resolution : 1.0;
+	for (int k = 0; k < 3; k++)
+		grid.dims[k] = std::max<std::int64_t>(1, std::min<std::int64_t>(resolution, (std::int64_t)std::ceil(extent(k) / grid.h)));
+
+	Cells cells;
+	Triangles triangles;
+
+	// Vertex pass: cluster means
+	{
+		std::rewind(soup.vertices);
+		std::vector<float> buffer(3 * 65536);
+		for (std::int64_t v = 0; v < soup.num_vertices;)
+		{
+			const std::size_t n = (std::size_t)std::min<std::int64_t>(65536, soup.num_vertices - v);
+			if (std::fread(buffer.data(), sizeof(float), 3 * n, soup.vertices) != 3 * n)
+				return false;
+			for (std::size_t i = 0; i < n; i++)
+			{
+				const double p[3] = { buffer[3 * i], buffer[3 * i + 1], buffer[3 * i + 2] };
+				Cell& cell = cells[grid.cell(p)];
+				for (int k = 0; k < 3; k++)
+					cell.sum[k] += p[k];
+				cell.count++;
+			}
+			v += n;
+			coarsen_to_fit(cluster_memory, grid, cells, triangles);
+		}
+	}
+
+	// Face pass: plane quadrics and surviving faces
+	{
+		VertexCache cache(soup.vertices, soup.num_vertices, vertex_memory);
+		std::rewind(soup.faces);
+		std::vector<std::int32_t> buffer(3 * 65536);
+		for (std::int64_t f = 0; f < soup.num_faces;)
+		{
+			const std::size_t n = (std::size_t)std::min<std::int64_t>(65536, soup.num_faces - f);
+			if (std::fread(buffer.data(), sizeof(std::int32_t), 3 * n, soup.faces) != 3 * n)
+				return false;
+			for (std::size_t i = 0; i < n; i++)
+			{
+				double p[3][3];
+				Triangle t;
+				for (int c = 0; c < 3; c++)
+				{
+					if (buffer[3 * i + c] >= soup.num_vertices)
+					{
+						std::cerr << "streaming_vertex_clustering: face index out of range in " << filename << std::endl;
+						return false;
+					}
+					cache.get(buffer[3 * i + c], p[c]);
+					t.c[c] = grid.cell(p[c]);
+				}
+				const Eigen::Vector3d v1(p[0][0], p[0][1], p[0][2]);
+				const Eigen::Vector3d v2(p[1][0], p[1][1], p[1][2]);
+				const Eigen::Vector3d v3(p[2][0], p[2][1], p[2][2]);
+				Eigen::Vector3d normal = (v2 - v1).cross(v3 - v1);
+				if (normal.squaredNorm() > 0)
+				{
+					normal.normalize();
+					const double plane[4] = { normal(0), normal(1), normal(2), -normal.dot(v1) };
+					for (int c = 0; c < 3; c++)
+					{
+						double* q = cells[t.c[c]].q;
+						for (int a = 0, k = 0; a < 4; a++)
+							for (int b = a; b < 4; b++)
+								q[k++] += plane[a] * plane[b];
+					}
+				}
+				if (t.c[0] != t.c[1] && t.c[1] != t.c[2] && t.c[2] != t.c[0])
+					triangles.insert(t);
+			}
+			f += n;
+			coarsen_to_fit(cluster_memory, grid, cells, triangles);
+			if (!cache.ok)
+				return false;
+		}
+	}
+
+	// Place the clusters that are still referenced, or all of them for a
+	// point cloud
+	int num_clusters = 0;
+	if (soup.num_faces == 0)
+	{
+		for (auto& entry : cells)
+			entry.second.index = num_clusters++;
+	}
+	for (const Triangle& t : triangles)
+		for (int c = 0; c < 3; c++)
+			if (cells[t.c[c]].index < 0)
+				cells[t.c[c]].index = num_clusters++;
+	Eigen::Matrix<double, 10, Eigen::Dynamic, Eigen::RowMajor> Q(10, num_clusters);
+	Eigen::Matrix<double, 3, Eigen::Dynamic, Eigen::RowMajor> mean(3, num_clusters), P;
+	std::vector<CellId> ids(num_clusters);
+	for (const auto& entry : cells)
+	{
+		const Cell& cell = entry.second;
+		if (cell.index < 0)
+			continue;
+		ids[cell.index] = entry.first;
+		for (int k = 0; k < 10; k++)
+			Q(k, cell.index) = cell.q[k];
+		for (int k = 0; k < 3; k++)
+			mean(k, cell.index) = cell.sum[k] / std::max(1, cell.count);
+	}
+	Eigen::VectorXd cost;
+	quadric_cost_and_placement_batch(Q, mean, mean, cost, P);
+	V.resize(num_clusters, 3);
+	const double size = grid.h * (1 << grid.level);
+	for (int i = 0; i < num_clusters; i++)
+	{
+		// Keep optimal placements that stray too far from their cell at
+		// the mean instead
+		std::int64_t c[3];
+		grid.decode(ids[i], grid.level, c);
+		bool inside = cost(i) < std::numeric_limits<double>::infinity();
+		for (int k = 0; k < 3; k++)
+		{
+			const double lower = grid.origin(k) + c[k] * size;
+			inside = inside && P(k, i) >= lower - 0.5 * size && P(k, i) <= lower + 1.5 * size;
+		}
+		V.row(i) = inside ? P.col(i).transpose() : mean.col(i).transpose();
+	}
+	F.resize(triangles.size(), 3);
+	int f = 0;
+	for (const Triangle& t : triangles)
+	{
+		for (int c = 0; c < 3; c++)
+			F(f, c) = cells[t.c[c]].index;
+		f++;
+	}
+	resolution = (int)std::max(std::max(grid.dim(0, grid.level), grid.dim(1, grid.level)), grid.dim(2, grid.level));
+	return true;
+}
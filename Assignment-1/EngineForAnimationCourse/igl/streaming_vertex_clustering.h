@@ -0,0 +1,50 @@
+#ifndef IGL_STREAMING_VERTEX_CLUSTERING_H
+#define IGL_STREAMING_VERTEX_CLUSTERING_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cstddef>
+#include <string>
+namespace igl
+{
+    // Reduce a mesh that may not fit in memory by vertex clustering with
+    // grid quadrics, reading it straight from an .obj or .off file. All
+    // vertices falling in the same cell of a regular grid are merged into
+    // one, placed at the minimum of the summed quadrics of their faces (the
+    // same plane quadrics as paper_vertex_quadrics); faces that end up with
+    // fewer than three distinct cells disappear. The result is meant as a
+    // coarse input for the QEM edge collapse pipeline.
+    //
+    // The file is parsed once in chunks into temporary binary vertex and
+    // face files, which are then streamed to accumulate the cells. Vertex
+    // positions are read back through a page cache, so only the cells, the
+    // output faces and a bounded part of the vertices are ever held in
+    // memory. Whenever the cells and faces grow past their share of
+    // max_memory the grid is coarsened by 2 on the fly (quadrics add up), so
+    // the result can be coarser than asked for; see resolution.
+    //
+    // Inputs:
+    //   filename  path to .obj or .off file (polygons are fan triangulated)
+    //   max_memory  approximate peak memory in bytes
+    // Outputs:
+    //   resolution  number of cells along the longest side of the bounding
+    //     box, as asked for on input, as used on output
+    //   V  #V by 3 list of cluster positions
+    //   F  #F by 3 list of faces into V
+    // Returns true on success, false on errors
+    //
+    // The output is not necessarily manifold: clusters can join sheets
+    // that were apart in the input. A file with vertices but no faces is a
+    // point cloud: V then has a point per occupied cell, at the mean of
+    // its vertices, and F is empty.
+    IGL_INLINE bool streaming_vertex_clustering(
+        const std::string& filename,
+        const std::size_t max_memory,
+        int& resolution,
+        Eigen::MatrixXd& V,
+        Eigen::MatrixXi& F);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "streaming_vertex_clustering.cpp"
+#endif
+#endif
@@ -0,0 +1,470 @@
+// Measures the decimation pipelines on closed manifold meshes and writes the
+// results as JSON, to track optimisation work on the decimator.
+//
+// Every mesh is decimated by every pipeline, once per pipeline, down to each
+// ratio in turn (finest first, continuing from the previous level):
+//   paper_set      edge_flaps, paper_cost_and_new_vertex for every edge and
+//                  the std::set queue of collapse_edge_new_impl (the original
+//                  viewer pipeline)
+//   quadric_heap   cached vertex quadrics, batched initial costs and the
+//                  indexed heap, one collapse at a time (collapse_edges)
+//   quadric_batch  same, collapsing independent sets in parallel
+//                  (collapse_edge_batch)
+// For each run the JSON has the init time (edge flaps, costs, queue), the
+// peak memory, and per level the faces left, the collapses, the time spent
+// collapsing, collapses per second and the Hausdorff distance to the input.
+//
+// Usage: decimationBenchmark_bin [options] [mesh ...]
+//   -r list   fractions of faces to keep (default 0.5,0.25,0.1)
+//   -m list   pipelines to run (default all of the above)
+//   -o file   output file (default: standard output)
+//   -n        skip the Hausdorff distances
+// Without meshes, the closed meshes of tutorial/data are used. Meshes that
+// can't be read or aren't closed manifolds are listed with their status.
+//
+// Peak memory is the peak resident set size of the process during the run.
+// It is reset before every run on Linux only; elsewhere it is the peak of
+// the process so far.
+#include <igl/read_triangle_mesh.h>
+#include <igl/boundary_facets.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/edge_flaps.h>
+#include <igl/remove_unreferenced.h>
+#include <igl/hausdorff.h>
+#include <igl/collapse_edge.h>
+#include <igl/collapse_edges.h>
+#include <igl/collapse_edge_batch.h>
+#include <igl/paper_cost_and_new_vertex.h>
+#include <igl/paper_vertex_quadrics.h>
+#include <igl/paper_quadric_collapse_edge_callbacks.h>
+#include <igl/paper_quadric_edge_costs.h>
+#include <igl/get_seconds.h>
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_WIN32)
+#  include <windows.h>
+#  include <psapi.h>
+#  pragma comment(lib, "psapi.lib")
+#elif !defined(__linux__)
+#  include <sys/resource.h>
+#endif
+
+#ifndef TUTORIAL_DATA_PATH
+#define TUTORIAL_DATA_PATH "../tutorial/data"
+#endif
+
+typedef std::function<void(
+	const int,
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	double&,
+	Eigen::RowVectorXd&)> CostFunction;
+typedef std::function<bool(
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const igl::IndexedMinHeap&,
+	const Eigen::MatrixXd&,
+	const int)> PreCollapse;
+typedef std::function<void(
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const igl::IndexedMinHeap&,
+	const Eigen::MatrixXd&,
+	const int,
+	const int,
+	const int,
+	const int,
+	const int,
+	const bool)> PostCollapse;
+
+struct Level
+{
+	double ratio;
+	int faces = 0;
+	int collapses = 0;
+	double decimate_seconds = 0;
+	double hausdorff = -1;
+};
+
+struct Run
+{
+	std::string method;
+	double edge_flaps_seconds = 0;
+	double cost_seconds = 0;
+	double queue_seconds = 0;
+	std::size_t peak_memory = 0;
+	std::vector<Level> levels;
+};
+
+// Peak resident set size in bytes since the last reset_peak_memory()
+static std::size_t peak_memory()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize : 0;
+#elif defined(__linux__)
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return (std::size_t)std::atoll(line.c_str() + 6) * 1024;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#  if defined(__APPLE__)
+	return (std::size_t)usage.ru_maxrss;
+#  else
+	return (std::size_t)usage.ru_maxrss * 1024;
+#  endif
+#endif
+}
+
+static void reset_peak_memory()
+{
+#if defined(__linux__)
+	// Writing 5 to clear_refs resets VmHWM to the current RSS
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5" << std::endl;
+#endif
+}
+
+static bool parse_list(const std::string& arg, std::vector<std::string>& items)
+{
+	std::stringstream ss(arg);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		if (item.empty())
+			return false;
+		items.push_back(item);
+	}
+	return !items.empty();
+}
+
+// Live faces and vertices of a decimated (V,F)
+static void compact(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, Eigen::MatrixXd& NV, Eigen::MatrixXi& NF)
+{
+	Eigen::MatrixXi G(F.rows(), 3);
+	int m = 0;
+	for (int f = 0; f < F.rows(); f++)
+	{
+		if (F(f, 0) != F(f, 1) || F(f, 1) != F(f, 2))
+			G.row(m++) = F.row(f);
+	}
+	G.conservativeResize(m, 3);
+	Eigen::VectorXi I;
+	igl::remove_unreferenced(V, G, NV, NF, I);
+}
+
+static Run run(const std::string& method, const Eigen::MatrixXd& OV, const Eigen::MatrixXi& OF,
+	const std::vector<double>& ratios, const bool hausdorff)
+{
+	Run res;
+	res.method = method;
+	reset_peak_memory();
+	Eigen::MatrixXd V = OV;
+	Eigen::MatrixXi F = OF;
+	Eigen::MatrixXi E, EF, EI;
+	Eigen::VectorXi EMAP;
+	Eigen::MatrixXd C;
+	Eigen::VectorXd costs;
+
+	double t = igl::get_seconds();
+	igl::edge_flaps(F, E, EMAP, EF, EI);
+	res.edge_flaps_seconds = igl::get_seconds() - t;
+
+	// paper_set
+	std::set<std::pair<double, int> > Q;
+	std::vector<std::set<std::pair<double, int> >::iterator > Qit;
+	// quadric_heap, quadric_batch
+	std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> > quadrics;
+	CostFunction cost_and_placement;
+	PreCollapse pre_collapse;
+	PostCollapse post_collapse;
+	igl::IndexedMinHeap H;
+
+	const bool use_set = method == "paper_set";
+	t = igl::get_seconds();
+	if (use_set)
+	{
+		cost_and_placement = igl::paper_cost_and_new_vertex;
+		costs.resize(E.rows());
+		C.resize(E.rows(), V.cols());
+		Eigen::RowVectorXd p(1, 3);
+		for (int e = 0; e < E.rows(); e++)
+		{
+			cost_and_placement(e, V, F, E, EMAP, EF, EI, costs(e), p);
+			C.row(e) = p;
+		}
+	}
+	else
+	{
+		igl::paper_vertex_quadrics(V, F, quadrics);
+		igl::paper_quadric_collapse_edge_callbacks(quadrics, cost_and_placement, pre_collapse, post_collapse);
+		igl::paper_quadric_edge_costs(quadrics, V, E, costs, C);
+	}
+	res.cost_seconds = igl::get_seconds() - t;
+
+	t = igl::get_seconds();
+	if (use_set)
+	{
+		Qit.resize(E.rows());
+		std::vector<std::pair<double, int> > sorted(E.rows());
+		for (int e = 0; e < E.rows(); e++)
+			sorted[e] = std::pair<double, int>(costs(e), e);
+		std::sort(sorted.begin(), sorted.end());
+		for (const auto& entry : sorted)
+			Qit[entry.second] = Q.insert(Q.end(), entry);
+	}
+	else
+	{
+		H.build(costs);
+	}
+	res.queue_seconds = igl::get_seconds() - t;
+
+	std::vector<double> collapse_costs;
+	int collapsed = 0;
+	double seconds = 0;
+	for (const double ratio : ratios)
+	{
+		Level level;
+		level.ratio = ratio;
+		// Every collapse removes two faces
+		const int target = std::max(0, (int)std::ceil((1.0 - ratio) * OF.rows() / 2) - collapsed);
+		t = igl::get_seconds();
+		if (use_set)
+		{
+			// A refused collapse puts its edge back at infinite cost; go on
+			// with the next edge, as collapse_edges does
+			int n = 0;
+			while (n < target && !Q.empty() && Q.begin()->first != std::numeric_limits<double>::infinity())
+			{
+				if (igl::collapse_edge_new_impl(cost_and_placement, V, F, E, EMAP, EF, EI, Q, Qit, C))
+					n++;
+			}
+			collapsed += n;
+		}
+		else if (method == "quadric_heap")
+		{
+			collapsed += igl::collapse_edges(cost_and_placement, pre_collapse, post_collapse, target,
+				std::numeric_limits<double>::infinity(), V, F, E, EMAP, EF, EI, H, C, collapse_costs);
+		}
+		else
+		{
+			collapsed += igl::collapse_edge_batch(cost_and_placement, pre_collapse, post_collapse, target,
+				std::numeric_limits<double>::infinity(), V, F, E, EMAP, EF, EI, H, C);
+		}
+		seconds += igl::get_seconds() - t;
+		level.collapses = collapsed;
+		level.decimate_seconds = seconds;
+		level.faces = OF.rows() - 2 * collapsed;
+		res.peak_memory = std::max(res.peak_memory, peak_memory());
+		if (hausdorff)
+		{
+			Eigen::MatrixXd LV;
+			Eigen::MatrixXi LF;
+			compact(V, F, LV, LF);
+			igl::hausdorff(OV, OF, LV, LF, level.hausdorff);
+		}
+		res.levels.push_back(level);
+	}
+	return res;
+}
+
+static std::string json_string(const std::string& s)
+{
+	std::string out = "\"";
+	for (const char c : s)
+	{
+		if (c == '"' || c == '\\')
+			out += std::string("\\") + c;
+		else if ((unsigned char)c < 0x20)
+		{
+			char code[8];
+			std::snprintf(code, sizeof(code), "\\u%04x", c);
+			out += code;
+		}
+		else
+			out += c;
+	}
+	return out + "\"";
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<double> ratios;
+	std::vector<std::string> methods;
+	std::vector<std::string> meshes;
+	std::string output;
+	bool hausdorff = true;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		std::vector<std::string> items;
+		if (arg == "-r" && has_value)
+		{
+			if (!parse_list(argv[++i], items))
+			{
+				std::cerr << "Bad ratio list " << argv[i] << std::endl;
+				return 1;
+			}
+			for (const auto& item : items)
+			{
+				char* end;
+				const double ratio = std::strtod(item.c_str(), &end);
+				if (*end != '\0' || ratio < 0 || ratio > 1)
+				{
+					std::cerr << "Bad ratio " << item << std::endl;
+					return 1;
+				}
+				ratios.push_back(ratio);
+			}
+		}
+		else if (arg == "-m" && has_value)
+		{
+			if (!parse_list(argv[++i], methods))
+			{
+				std::cerr << "Bad pipeline list " << argv[i] << std::endl;
+				return 1;
+			}
+			for (const auto& method : methods)
+			{
+				if (method != "paper_set" && method != "quadric_heap" && method != "quadric_batch")
+				{
+					std::cerr << "Unknown pipeline " << method << std::endl;
+					return 1;
+				}
+			}
+		}
+		else if (arg == "-o" && has_value)
+			output = argv[++i];
+		else if (arg == "-n")
+			hausdorff = false;
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			std::cerr << "Usage: " << argv[0] << " [-r ratios] [-m pipelines] [-o file.json] [-n] [mesh ...]" << std::endl;
+			return 1;
+		}
+		else
+			meshes.push_back(arg);
+	}
+	if (ratios.empty())
+		ratios = { 0.5, 0.25, 0.1 };
+	// Finest level first, each level continues from the previous one
+	std::sort(ratios.rbegin(), ratios.rend());
+	if (methods.empty())
+		methods = { "paper_set", "quadric_heap", "quadric_batch" };
+	if (meshes.empty())
+	{
+		for (const char* name : { "bunny.off", "fertility.off", "cheburashka.off", "bumpy-cube.obj", "armadillo.obj", "cube_40k.obj" })
+			meshes.push_back(std::string(TUTORIAL_DATA_PATH) + "/" + name);
+	}
+
+	std::ofstream file;
+	if (!output.empty())
+	{
+		file.open(output);
+		if (!file)
+		{
+			std::cerr << "Can't open " << output << std::endl;
+			return 1;
+		}
+	}
+	std::stringstream json;
+	json.precision(10);
+	json << "{\n  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n  \"ratios\": [";
+	for (size_t i = 0; i < ratios.size(); i++)
+		json << (i ? ", " : "") << ratios[i];
+	json << "],\n  \"meshes\": [";
+	for (size_t m = 0; m < meshes.size(); m++)
+	{
+		const std::string& mesh = meshes[m];
+		const std::string name = mesh.substr(mesh.find_last_of("/\\") + 1);
+		json << (m ? "," : "") << "\n    {\n      \"file\": " << json_string(mesh) << ",\n      \"name\": " << json_string(name);
+		Eigen::MatrixXd V;
+		Eigen::MatrixXi F, B;
+		double t = igl::get_seconds();
+		std::string status = "ok";
+		if (!igl::read_triangle_mesh(mesh, V, F) || F.rows() == 0)
+			status = "can't read mesh";
+		const double read_seconds = igl::get_seconds() - t;
+		if (status == "ok")
+		{
+			igl::boundary_facets(F, B);
+			if (B.rows() > 0 || !igl::is_edge_manifold(F))
+				status = "not a closed manifold mesh";
+		}
+		json << ",\n      \"status\": " << json_string(status);
+		if (status != "ok")
+		{
+			std::cerr << name << ": " << status << std::endl;
+			json << "\n    }";
+			continue;
+		}
+		const double diagonal = (V.colwise().maxCoeff() - V.colwise().minCoeff()).norm();
+		json << ",\n      \"vertices\": " << V.rows() << ",\n      \"faces\": " << F.rows()
+			<< ",\n      \"read_seconds\": " << read_seconds << ",\n      \"runs\": [";
+		for (size_t r = 0; r < methods.size(); r++)
+		{
+			const Run res = run(methods[r], V, F, ratios, hausdorff);
+			const double init_seconds = res.edge_flaps_seconds + res.cost_seconds + res.queue_seconds;
+			std::cerr << name << " " << res.method << ": init " << init_seconds << "s, "
+				<< res.levels.back().collapses << " collapses in " << res.levels.back().decimate_seconds << "s" << std::endl;
+			json << (r ? "," : "") << "\n        {\n          \"method\": " << json_string(res.method)
+				<< ",\n          \"init_seconds\": " << init_seconds
+				<< ",\n          \"edge_flaps_seconds\": " << res.edge_flaps_seconds
+				<< ",\n          \"cost_seconds\": " << res.cost_seconds
+				<< ",\n          \"queue_seconds\": " << res.queue_seconds
+				<< ",\n          \"peak_memory_bytes\": " << res.peak_memory
+				<< ",\n          \"levels\": [";
+			for (size_t l = 0; l < res.levels.size(); l++)
+			{
+				const Level& level = res.levels[l];
+				json << (l ? "," : "") << "\n            { \"ratio\": " << level.ratio
+					<< ", \"faces\": " << level.faces
+					<< ", \"collapses\": " << level.collapses
+					<< ", \"decimate_seconds\": " << level.decimate_seconds
+					<< ", \"collapses_per_second\": " << (level.decimate_seconds > 0 ? level.collapses / level.decimate_seconds : 0);
+				if (hausdorff)
+				{
+					json << ", \"hausdorff\": " << level.hausdorff
+						<< ", \"relative_hausdorff\": " << level.hausdorff / diagonal;
+				}
+				json << " }";
+			}
+			json << "\n          ]\n        }";
+		}
+		json << "\n      ]\n    }";
+	}
+	json << "\n  ]\n}\n";
+	(output.empty() ? std::cout : file) << json.str();
+	return 0;
+}
@@ -0,0 +1,528 @@
+// Generates levels of detail for many meshes without a window, using the
+// cached-quadric paper QEM decimation of the viewer.
+//
+// Every mesh is decimated once, far enough for its coarsest LOD, while the
+// collapses are recorded in a ProgressiveMesh; each LOD is then cut out of
+// that log. Meshes are processed concurrently, one per worker thread; with
+// more than one thread the kernels within a mesh run serially, so that the
+// threads do not each start one per core.
+//
+// Usage: lodGenerator_bin [options] mesh ...
+//   -r list   fractions of faces to keep, e.g. 0.5,0.25,0.1
+//   -e list   QEM error thresholds: decimate until the next collapse would
+//             cost more than the threshold, e.g. 1e-6,1e-4
+//   -o dir    output directory (default .), created if missing; LODs are
+//             written as <name>_lod<i>.<ext> with the extension of the input
+//   -c file   CSV file with per LOD timing and error stats
+//             (default <output dir>/lod_stats.csv)
+//   -j n      number of meshes processed at once (default: hardware threads)
+//   -n        skip the Hausdorff distance to the input
+//   -s mb     stream .obj/.off input too large for memory through
+//             streaming_vertex_clustering, using about mb megabytes, and
+//             decimate the clustered mesh; ratios and Hausdorff distances
+//             are then relative to the clustered mesh
+//   -g n      grid cells along the longest side for -s (default 512)
+// Without -r and -e the ratios 0.5,0.25,0.1 are used. A mesh that fails is
+// listed in the CSV with its error and the others are still processed.
+#include <igl/read_triangle_mesh.h>
+#include <igl/write_triangle_mesh.h>
+#include <igl/boundary_facets.h>
+#include <igl/connect_boundary_to_infinity.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/edge_flaps.h>
+#include <igl/remove_unreferenced.h>
+#include <igl/hausdorff.h>
+#include <igl/AABB.h>
+#include <igl/collapse_edges.h>
+#include <igl/paper_vertex_quadrics.h>
+#include <igl/paper_quadric_collapse_edge_callbacks.h>
+#include <igl/paper_quadric_edge_costs.h>
+#include <igl/progressive_mesh_collapse_edge_callbacks.h>
+#include <igl/streaming_vertex_clustering.h>
+#include <igl/ProgressiveMesh.h>
+#include <igl/get_seconds.h>
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#  include <direct.h>
+#endif
+
+typedef std::function<void(
+	const int,
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	double&,
+	Eigen::RowVectorXd&)> CostFunction;
+typedef std::function<bool(
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const igl::IndexedMinHeap&,
+	const Eigen::MatrixXd&,
+	const int)> PreCollapse;
+typedef std::function<void(
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const igl::IndexedMinHeap&,
+	const Eigen::MatrixXd&,
+	const int,
+	const int,
+	const int,
+	const int,
+	const int,
+	const bool)> PostCollapse;
+
+struct LodTarget
+{
+	bool is_ratio; // fraction of faces to keep, else error threshold
+	double value;
+};
+
+struct Options
+{
+	std::vector<LodTarget> targets;
+	std::string output_dir = ".";
+	std::string csv;
+	int threads = 0;
+	bool hausdorff = true;
+	// streaming_vertex_clustering memory in bytes, 0 to read in core
+	std::size_t stream_memory = 0;
+	int grid = 512;
+};
+
+// One CSV row per LOD (or one row with the error for a mesh that failed)
+struct LodStats
+{
+	std::string file;
+	int lod = -1;
+	LodTarget target = { true, 0 };
+	int faces = 0;
+	int vertices = 0;
+	int collapses = 0;
+	double max_cost = 0;
+	double hausdorff = 0;
+	double read_seconds = 0;
+	double init_seconds = 0;
+	double decimate_seconds = 0;
+	double lod_seconds = 0;
+	std::string output;
+	std::string status = "ok";
+};
+
+static LodStats failed_stats(const std::string& file, std::string error)
+{
+	// Keep the CSV row intact
+	std::replace(error.begin(), error.end(), ',', ';');
+	std::replace(error.begin(), error.end(), '\n', ' ');
+	LodStats stats;
+	stats.file = file;
+	stats.status = "failed: " + error;
+	return stats;
+}
+
+static bool parse_list(const std::string& arg, const bool is_ratio, std::vector<LodTarget>& targets)
+{
+	std::stringstream ss(arg);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		char* end;
+		const double value = std::strtod(item.c_str(), &end);
+		if (item.empty() || *end != '\0' || value < 0 || (is_ratio && value > 1))
+			return false;
+		targets.push_back({ is_ratio, value });
+	}
+	return true;
+}
+
+// Create dir and any missing parent, like mkdir -p
+static bool make_directories(const std::string& dir)
+{
+	for (size_t i = 1; i <= dir.size(); i++)
+	{
+		if (i < dir.size() && dir[i] != '/' && dir[i] != '\\')
+			continue;
+		// Fails for the parts that exist, which is checked below
+#if defined(_WIN32)
+		_mkdir(dir.substr(0, i).c_str());
+#else
+		mkdir(dir.substr(0, i).c_str(), 0777);
+#endif
+	}
+	struct stat info;
+	return stat(dir.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFDIR;
+}
+
+// Drop the dead faces and unreferenced vertices left by collapse_edge, and
+// the faces to the point at infinity (vertices past num_vertices)
+static void compact(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F, const int num_vertices, Eigen::MatrixXd& NV, Eigen::MatrixXi& NF)
+{
+	Eigen::MatrixXi G(F.rows(), 3);
+	int m = 0;
+	for (int f = 0; f < F.rows(); f++)
+	{
+		if ((F(f, 0) != F(f, 1) || F(f, 1) != F(f, 2)) && F.row(f).maxCoeff() < num_vertices)
+			G.row(m++) = F.row(f);
+	}
+	G.conservativeResize(m, 3);
+	Eigen::VectorXi I;
+	igl::remove_unreferenced(V, G, NV, NF, I);
+}
+
+// Drop faces until F connected to infinity is a consistently oriented edge
+// manifold, which is what collapse_edge needs (see decimate). Vertex
+// clustering can join sheets along edges and at vertices, and flip thin
+// parts.
+static void remove_non_manifold_faces(const Eigen::MatrixXd& V, Eigen::MatrixXi& F)
+{
+	while (F.rows() > 0)
+	{
+		Eigen::MatrixXi FO;
+		igl::connect_boundary_to_infinity(F, (int)V.rows(), FO);
+		// min, max, whether min->max, face of every directed edge
+		std::vector<std::array<int, 4> > edges;
+		edges.reserve(3 * FO.rows());
+		for (int f = 0; f < FO.rows(); f++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				const int a = FO(f, (k + 1) % 3);
+				const int b = FO(f, (k + 2) % 3);
+				edges.push_back({ std::min(a, b), std::max(a, b), a < b, f });
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+		std::vector<bool> drop_face(F.rows(), false), drop_vertex(V.rows(), false);
+		bool manifold = true;
+		for (size_t i = 0, j; i < edges.size(); i = j)
+		{
+			for (j = i + 1; j < edges.size() && edges[j][0] == edges[i][0] && edges[j][1] == edges[i][1]; j++)
+				;
+			if (j - i == 2 && edges[i][2] != edges[i + 1][2])
+				continue;
+			manifold = false;
+			for (size_t k = i; k < j; k++)
+			{
+				if (edges[k][3] < F.rows())
+					drop_face[edges[k][3]] = true;
+				else
+					// Vertex with several boundary loops: drop the faces around it
+					drop_vertex[edges[k][0]] = true;
+			}
+		}
+		if (manifold)
+			return;
+		Eigen::MatrixXi G(F.rows(), 3);
+		int m = 0;
+		for (int f = 0; f < F.rows(); f++)
+		{
+			if (!drop_face[f] && !drop_vertex[F(f, 0)] && !drop_vertex[F(f, 1)] && !drop_vertex[F(f, 2)])
+				G.row(m++) = F.row(f);
+		}
+		G.conservativeResize(m, 3);
+		F = G;
+	}
+}
+
+// Largest squared distance from the points P to the mesh (V, F), one point
+// at a time rather than with the parallel_for of AABB::squared_distance
+static double max_squared_distance(const Eigen::MatrixXd& P, const Eigen::MatrixXd& V, const Eigen::MatrixXi& F)
+{
+	igl::AABB<Eigen::MatrixXd, 3> tree;
+	tree.init(V, F);
+	double max_sqr_d = 0;
+	int i;
+	Eigen::RowVector3d c;
+	for (int p = 0; p < P.rows(); p++)
+		max_sqr_d = std::max(max_sqr_d, tree.squared_distance(V, F, Eigen::RowVector3d(P.row(p)), i, c));
+	return max_sqr_d;
+}
+
+// Same as igl::hausdorff, on the calling thread only
+static double serial_hausdorff(const Eigen::MatrixXd& VA, const Eigen::MatrixXi& FA, const Eigen::MatrixXd& VB, const Eigen::MatrixXi& FB)
+{
+	return std::sqrt(std::max(max_squared_distance(VB, VA, FA), max_squared_distance(VA, VB, FB)));
+}
+
+static std::vector<LodStats> process(const std::string& file, const Options& options)
+{
+	// With one mesh at a time, the work within a mesh can use all cores
+	const bool parallel = options.threads == 1;
+	LodStats stats;
+	stats.file = file;
+	std::vector<LodStats> rows;
+
+	double t = igl::get_seconds();
+	Eigen::MatrixXd OV;
+	Eigen::MatrixXi OF;
+	if (options.stream_memory > 0)
+	{
+		int resolution = options.grid;
+		if (!igl::streaming_vertex_clustering(file, options.stream_memory, resolution, OV, OF))
+		{
+			stats.status = "can't read mesh";
+			return { stats };
+		}
+		if (OF.rows() == 0)
+		{
+			stats.status = "no faces to decimate";
+			return { stats };
+		}
+		remove_non_manifold_faces(OV, OF);
+		if (OF.rows() == 0)
+		{
+			stats.status = "nothing left after clustering";
+			return { stats };
+		}
+	}
+	else
+	{
+		if (!igl::read_triangle_mesh(file, OV, OF))
+		{
+			stats.status = "can't read mesh";
+			return { stats };
+		}
+		if (OF.rows() == 0)
+		{
+			stats.status = "no faces to decimate";
+			return { stats };
+		}
+		Eigen::MatrixXi B;
+		igl::boundary_facets(OF, B);
+		if (B.rows() > 0 || !igl::is_edge_manifold(OF))
+		{
+			stats.status = "not a closed manifold mesh";
+			return { stats };
+		}
+	}
+	stats.read_seconds = igl::get_seconds() - t;
+
+	t = igl::get_seconds();
+	// Clustered meshes can have holes: close them with a point at infinity
+	// as decimate does. Its edges cost infinity, so boundaries stay put.
+	Eigen::MatrixXd V;
+	Eigen::MatrixXi F;
+	igl::connect_boundary_to_infinity(OV, OF, V, F);
+	Eigen::MatrixXi E, EF, EI;
+	Eigen::VectorXi EMAP;
+	igl::edge_flaps(F, E, EMAP, EF, EI);
+	std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> > quadrics;
+	igl::paper_vertex_quadrics(V, F, quadrics);
+	CostFunction cost_and_placement;
+	PreCollapse pre_collapse;
+	PostCollapse post_collapse;
+	igl::paper_quadric_collapse_edge_callbacks(quadrics, cost_and_placement, pre_collapse, post_collapse);
+	igl::ProgressiveMesh pm;
+	pm.clear(V.cols());
+	igl::progressive_mesh_collapse_edge_callbacks(pm, pre_collapse, post_collapse);
+	Eigen::MatrixXd C;
+	Eigen::VectorXd edge_costs;
+	igl::paper_quadric_edge_costs(quadrics, V, E, edge_costs, C, parallel);
+	igl::IndexedMinHeap Q;
+	Q.build(edge_costs);
+	stats.init_seconds = igl::get_seconds() - t;
+
+	// Go as far as the coarsest ratio and the largest threshold need
+	int max_collapses = 0;
+	double max_cost = -std::numeric_limits<double>::infinity();
+	for (const auto& target : options.targets)
+	{
+		if (target.is_ratio)
+			max_collapses = std::max(max_collapses, (int)std::ceil((1.0 - target.value) * OF.rows() / 2));
+		else
+			max_cost = std::max(max_cost, target.value);
+	}
+	t = igl::get_seconds();
+	std::vector<double> costs;
+	igl::collapse_edges(cost_and_placement, pre_collapse, post_collapse, max_collapses,
+		std::numeric_limits<double>::infinity(), V, F, E, EMAP, EF, EI, Q, C, costs);
+	igl::collapse_edges(cost_and_placement, pre_collapse, post_collapse, std::numeric_limits<int>::max(),
+		max_cost, V, F, E, EMAP, EF, EI, Q, C, costs);
+	stats.decimate_seconds = igl::get_seconds() - t;
+
+	const std::string name = file.substr(file.find_last_of("/\\") + 1);
+	const size_t dot = name.find_last_of('.');
+	const std::string stem = name.substr(0, dot);
+	const std::string ext = dot == std::string::npos ? ".obj" : name.substr(dot);
+	for (int i = 0; i < (int)options.targets.size(); i++)
+	{
+		t = igl::get_seconds();
+		LodStats row = stats;
+		row.lod = i;
+		row.target = options.targets[i];
+		if (row.target.is_ratio)
+		{
+			row.collapses = std::min(pm.size(), (int)std::ceil((1.0 - row.target.value) * OF.rows() / 2));
+		}
+		else
+		{
+			// Stop before the first collapse above the threshold
+			row.collapses = 0;
+			while (row.collapses < pm.size() && costs[row.collapses] <= row.target.value)
+				row.collapses++;
+		}
+		pm.seek(row.collapses, V, F);
+		for (int c = 0; c < row.collapses; c++)
+			row.max_cost = std::max(row.max_cost, costs[c]);
+
+		Eigen::MatrixXd LV;
+		Eigen::MatrixXi LF;
+		compact(V, F, OV.rows(), LV, LF);
+		row.faces = LF.rows();
+		row.vertices = LV.rows();
+		row.output = options.output_dir + "/" + stem + "_lod" + std::to_string(i) + ext;
+		if (!igl::write_triangle_mesh(row.output, LV, LF))
+			row.status = "can't write " + row.output;
+		if (options.hausdorff && parallel)
+			igl::hausdorff(OV, OF, LV, LF, row.hausdorff);
+		else if (options.hausdorff)
+			row.hausdorff = serial_hausdorff(OV, OF, LV, LF);
+		row.lod_seconds = igl::get_seconds() - t;
+		rows.push_back(row);
+	}
+	return rows;
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	std::vector<std::string> meshes;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (arg == "-r" && has_value)
+		{
+			if (!parse_list(argv[++i], true, options.targets))
+			{
+				std::cerr << "Bad ratio list " << argv[i] << std::endl;
+				return 1;
+			}
+		}
+		else if (arg == "-e" && has_value)
+		{
+			if (!parse_list(argv[++i], false, options.targets))
+			{
+				std::cerr << "Bad threshold list " << argv[i] << std::endl;
+				return 1;
+			}
+		}
+		else if (arg == "-o" && has_value)
+			options.output_dir = argv[++i];
+		else if (arg == "-c" && has_value)
+			options.csv = argv[++i];
+		else if (arg == "-j" && has_value)
+			options.threads = std::atoi(argv[++i]);
+		else if (arg == "-n")
+			options.hausdorff = false;
+		else if (arg == "-s" && has_value)
+			options.stream_memory = (std::size_t)(std::atof(argv[++i]) * (1 << 20));
+		else if (arg == "-g" && has_value)
+			options.grid = std::atoi(argv[++i]);
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			std::cerr << "Unknown option " << arg << std::endl;
+			return 1;
+		}
+		else
+			meshes.push_back(arg);
+	}
+	if (meshes.empty())
+	{
+		std::cerr << "Usage: " << argv[0] << " [-r ratios] [-e thresholds] [-o dir] [-c stats.csv] [-j threads] [-n] [-s mb] [-g cells] mesh ..." << std::endl;
+		return 1;
+	}
+	if (options.targets.empty())
+		parse_list("0.5,0.25,0.1", true, options.targets);
+	if (options.csv.empty())
+		options.csv = options.output_dir + "/lod_stats.csv";
+	if (options.threads <= 0)
+		options.threads = std::max(1u, std::thread::hardware_concurrency());
+	options.threads = std::min(options.threads, (int)meshes.size());
+	if (!make_directories(options.output_dir))
+	{
+		std::cerr << "Can't create " << options.output_dir << std::endl;
+		return 1;
+	}
+
+	// Workers take the next mesh until none is left. A mesh that throws is
+	// recorded as failed and the others go on.
+	std::vector<std::vector<LodStats> > results(meshes.size());
+	std::atomic<int> next(0);
+	std::mutex log_mutex;
+	const auto worker = [&]()
+	{
+		for (int i = next++; i < (int)meshes.size(); i = next++)
+		{
+			try
+			{
+				results[i] = process(meshes[i], options);
+			}
+			catch (const std::exception& e)
+			{
+				results[i] = { failed_stats(meshes[i], e.what()) };
+			}
+			catch (...)
+			{
+				results[i] = { failed_stats(meshes[i], "unknown error") };
+			}
+			std::lock_guard<std::mutex> lock(log_mutex);
+			std::cerr << meshes[i] << ": " << results[i].front().status << std::endl;
+		}
+	};
+	const double t = igl::get_seconds();
+	std::vector<std::thread> pool;
+	for (int i = 0; i < options.threads; i++)
+		pool.emplace_back(worker);
+	for (auto& thread : pool)
+		thread.join();
+	std::cerr << meshes.size() << " meshes in " << igl::get_seconds() - t << "s" << std::endl;
+
+	std::ofstream csv(options.csv);
+	if (!csv)
+	{
+		std::cerr << "Can't open " << options.csv << std::endl;
+		return 1;
+	}
+	csv.precision(10);
+	csv << "file,lod,criterion,target,faces,vertices,collapses,max_cost,hausdorff,"
+		"read_s,init_s,decimate_s,lod_s,output,status" << std::endl;
+	int failed = 0;
+	for (const auto& rows : results)
+	{
+		for (const auto& row : rows)
+		{
+			csv << row.file << "," << row.lod << "," << (row.target.is_ratio ? "ratio" : "error") << ","
+				<< row.target.value << "," << row.faces << "," << row.vertices << "," << row.collapses << ","
+				<< row.max_cost << "," << row.hausdorff << "," << row.read_seconds << "," << row.init_seconds << ","
+				<< row.decimate_seconds << "," << row.lod_seconds << "," << row.output << "," << row.status << std::endl;
+			failed += row.status != "ok";
+		}
+	}
+	return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+// Compares the std::set and the indexed heap edge-collapse queues of
+// collapse_edge_new_impl on closed manifold meshes.
+//
+// Usage: queueBenchmark_bin [ratio] [mesh ...]
+//   ratio  fraction of faces to keep (default 0.1)
+//   mesh   OFF/OBJ files (default: a few of the tutorial/data meshes)
+#include <igl/read_triangle_mesh.h>
+#include <igl/boundary_facets.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/edge_flaps.h>
+#include <igl/collapse_edge.h>
+#include <igl/shortest_edge_and_midpoint.h>
+#include <igl/paper_cost_and_new_vertex.h>
+#include <igl/get_seconds.h>
+#include <Eigen/Core>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+#include <set>
+
+#ifndef TUTORIAL_DATA_PATH
+#define TUTORIAL_DATA_PATH "../tutorial/data"
+#endif
+
+typedef std::function<void(
+	const int,
+	const Eigen::MatrixXd&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::VectorXi&,
+	const Eigen::MatrixXi&,
+	const Eigen::MatrixXi&,
+	double&,
+	Eigen::RowVectorXd&)> CostFunction;
+
+struct RunResult
+{
+	double init_seconds;
+	double collapse_seconds;
+	int num_collapsed;
+	Eigen::MatrixXi F;
+};
+
+// Decimate a copy of (V,F) until target_collapses edges were collapsed or no
+// edge is left to collapse, using either queue implementation. A collapse
+// that is refused puts its edge back at infinite cost and the next edge is
+// tried, the way collapse_edges does.
+static RunResult run(const Eigen::MatrixXd& OV, const Eigen::MatrixXi& OF,
+	const CostFunction& cost_and_placement, const bool use_heap, const int target_collapses)
+{
+	RunResult res;
+	Eigen::MatrixXd V = OV;
+	Eigen::MatrixXi F = OF;
+	Eigen::MatrixXi E, EF, EI;
+	Eigen::VectorXi EMAP;
+	Eigen::MatrixXd C;
+	std::set<std::pair<double, int> > Q;
+	std::vector<std::set<std::pair<double, int> >::iterator > Qit;
+	igl::IndexedMinHeap H;
+
+	double t = igl::get_seconds();
+	igl::edge_flaps(F, E, EMAP, EF, EI);
+	C.resize(E.rows(), V.cols());
+	if (use_heap)
+		H.resize(E.rows());
+	else
+		Qit.resize(E.rows());
+	Eigen::RowVectorXd p(1, 3);
+	for (int e = 0; e < E.rows(); e++)
+	{
+		double cost;
+		cost_and_placement(e, V, F, E, EMAP, EF, EI, cost, p);
+		C.row(e) = p;
+		if (use_heap)
+			H.push(e, cost);
+		else
+			Qit[e] = Q.insert(std::pair<double, int>(cost, e)).first;
+	}
+	res.init_seconds = igl::get_seconds() - t;
+
+	t = igl::get_seconds();
+	res.num_collapsed = 0;
+	const double inf = std::numeric_limits<double>::infinity();
+	while (res.num_collapsed < target_collapses)
+	{
+		if (use_heap ? H.empty() || H.top().first == inf : Q.empty() || Q.begin()->first == inf)
+			break;
+		const bool collapsed = use_heap ?
+			igl::collapse_edge_new_impl(cost_and_placement, V, F, E, EMAP, EF, EI, H, C) :
+			igl::collapse_edge_new_impl(cost_and_placement, V, F, E, EMAP, EF, EI, Q, Qit, C);
+		if (collapsed)
+			res.num_collapsed++;
+	}
+	res.collapse_seconds = igl::get_seconds() - t;
+	res.F = F;
+	return res;
+}
+
+int main(int argc, char* argv[])
+{
+	double ratio = 0.1;
+	std::vector<std::string> meshes;
+	if (argc > 1)
+		ratio = std::atof(argv[1]);
+	for (int i = 2; i < argc; i++)
+		meshes.push_back(argv[i]);
+	if (meshes.empty())
+	{
+		for (const char* name : { "bunny.off", "fertility.off", "cheburashka.off", "bumpy-cube.obj", "armadillo.obj" })
+			meshes.push_back(std::string(TUTORIAL_DATA_PATH) + "/" + name);
+	}
+
+	const std::vector<std::pair<std::string, CostFunction> > costs = {
+		{ "shortest_edge", igl::shortest_edge_and_midpoint },
+		{ "paper_cost", igl::paper_cost_and_new_vertex } };
+
+	std::cout << std::left << std::setw(20) << "mesh" << std::setw(15) << "cost"
+		<< std::setw(10) << "#F" << std::setw(10) << "target"
+		<< std::setw(10) << "set done" << std::setw(11) << "heap done"
+		<< std::setw(12) << "set init" << std::setw(12) << "heap init"
+		<< std::setw(12) << "set [s]" << std::setw(12) << "heap [s]"
+		<< std::setw(9) << "speedup" << "same" << std::endl;
+	for (const auto& mesh : meshes)
+	{
+		Eigen::MatrixXd V;
+		Eigen::MatrixXi F, B;
+		if (!igl::read_triangle_mesh(mesh, V, F))
+		{
+			std::cerr << "Can't open file " << mesh << std::endl;
+			continue;
+		}
+		igl::boundary_facets(F, B);
+		if (B.rows() > 0 || !igl::is_edge_manifold(F))
+		{
+			std::cerr << "Skipping " << mesh << ": collapse_edge needs a closed manifold mesh" << std::endl;
+			continue;
+		}
+		// Every collapse removes two faces
+		const int target_collapses = (int)((1.0 - ratio) * F.rows() / 2);
+		const std::string name = mesh.substr(mesh.find_last_of("/\\") + 1);
+		for (const auto& cost : costs)
+		{
+			const RunResult with_set = run(V, F, cost.second, false, target_collapses);
+			const RunResult with_heap = run(V, F, cost.second, true, target_collapses);
+			std::cout << std::left << std::setw(20) << name << std::setw(15) << cost.first
+				<< std::setw(10) << F.rows() << std::setw(10) << target_collapses
+				<< std::setw(10) << with_set.num_collapsed << std::setw(11) << with_heap.num_collapsed
+				<< std::setw(12) << with_set.init_seconds << std::setw(12) << with_heap.init_seconds
+				<< std::setw(12) << with_set.collapse_seconds << std::setw(12) << with_heap.collapse_seconds
+				<< std::setw(9) << std::setprecision(3) << with_set.collapse_seconds / with_heap.collapse_seconds
+				<< (with_set.F == with_heap.F ? "yes" : "NO") << std::setprecision(6) << std::endl;
+		}
+	}
+	return 0;
+}
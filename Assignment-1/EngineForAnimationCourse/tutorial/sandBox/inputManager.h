@@ -184,6 +184,14 @@ static void glfw_key_callback(GLFWwindow* window, int key, int scancode, int act
 		case 'R':
 			scn->reset();
 			break;
+		case GLFW_KEY_MINUS:
+			scn->refine();
+			break;
+		case 'b':
+		case 'B':
+			scn->use_batch_decimation = !scn->use_batch_decimation;
+			std::cout << "batch decimation " << (scn->use_batch_decimation ? "on" : "off") << std::endl;
+			break;
 		default:
 			Eigen::Vector3f shift;
 			float scale;
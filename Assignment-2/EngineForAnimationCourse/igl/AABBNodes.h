@@ -0,0 +1,25 @@
+#ifndef IGL_AABB_NODES_H
+#define IGL_AABB_NODES_H
+#include "AABB.h"
+#include <Eigen/Core>
+namespace igl
+{
+    // View of an igl::AABB tree of triangles through the node interface of
+    // FlatBVH, so that tree walks are written once for both
+    struct AABBNodes
+    {
+        typedef AABB<Eigen::MatrixXd, 3> Tree;
+        typedef const Tree* NodeRef;
+        explicit AABBNodes(const Tree& tree) : m_tree(tree) {}
+        NodeRef root() const { return &m_tree; }
+        bool is_leaf(const NodeRef n) const { return n->is_leaf(); }
+        NodeRef left(const NodeRef n) const { return n->m_left; }
+        NodeRef right(const NodeRef n) const { return n->m_right; }
+        const Eigen::AlignedBox<double, 3>& box(const NodeRef n) const { return n->m_box; }
+        int size(const NodeRef) const { return 1; }
+        int primitive(const NodeRef n, const int) const { return n->m_primitive; }
+
+        const Tree& m_tree;
+    };
+}
+#endif
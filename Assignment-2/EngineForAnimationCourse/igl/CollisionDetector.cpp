@@ -0,0 +1,115 @@
+#include "CollisionDetector.h"
+#include "FlatBVH.h"
+#include "RelativeFrame.h"
+#include "aabb_trees_time_of_impact.h"
+#include "get_seconds.h"
+#include <algorithm>
+
+IGL_INLINE igl::CollisionDetector::CollisionDetector(const int num_threads)
+	: m_use_fronts(true), m_workers(num_threads), m_frame(0)
+{
+}
+
+IGL_INLINE void igl::CollisionDetector::detect(
+	const std::vector<const Eigen::MatrixXd*>& V,
+	const std::vector<const Eigen::MatrixXi*>& F,
+	const std::vector<FlatBVH*>& trees,
+	const Transforms& transforms,
+	const std::vector<Eigen::Vector3d>& displacements,
+	std::vector<Contact>& contacts)
+{
+	double tic = get_seconds();
+	const int n = trees.size();
+	m_world_boxes.resize(n);
+	for (int i = 0; i < n; i++)
+	{
+		// World bounds of the oriented root box of the tree, swept over the
+		// step
+		const Eigen::Matrix4d& trans = transforms[i];
+		const Eigen::Vector3d center = trans.topLeftCorner<3, 3>() * trees[i]->m_box.center() + trans.topRightCorner<3, 1>();
+		const Eigen::Vector3d half = trans.topLeftCorner<3, 3>().cwiseAbs() * (0.5 * trees[i]->m_box.sizes());
+		m_world_boxes[i] = Eigen::AlignedBox<double, 3>(center - half, center + half);
+		m_world_boxes[i].extend(center - half + displacements[i]);
+		m_world_boxes[i].extend(center + half + displacements[i]);
+	}
+	m_broad_phase.update(m_world_boxes);
+
+	// Pairs with something moving, in a fixed order so that the results
+	// do not depend on the threads
+	m_candidates.clear();
+	for (const auto& pair : m_broad_phase.pairs())
+		if (!displacements[pair.first].isZero(0) || !displacements[pair.second].isZero(0))
+			m_candidates.push_back(pair);
+	std::sort(m_candidates.begin(), m_candidates.end());
+	m_stats.broad_phase_pairs = m_broad_phase.pairs().size();
+	m_stats.candidates = m_candidates.size();
+	m_stats.broad_phase_seconds = get_seconds() - tic;
+
+	// Fronts of the candidates, new ones for new candidates; the others
+	// are dropped
+	m_frame++;
+	m_candidate_fronts.assign(m_candidates.size(), nullptr);
+	if (m_use_fronts)
+	{
+		for (size_t k = 0; k < m_candidates.size(); k++)
+		{
+			CachedFront& cached = m_fronts[(std::uint64_t(m_candidates[k].first) << 32) | std::uint32_t(m_candidates[k].second)];
+			cached.frame = m_frame;
+			m_candidate_fronts[k] = &cached.front;
+		}
+	}
+	for (auto it = m_fronts.begin(); it != m_fronts.end();)
+	{
+		if (it->second.frame != m_frame)
+			it = m_fronts.erase(it);
+		else
+			++it;
+	}
+
+	// Narrow phase on the workers, each into its own buffer; the meshes
+	// and trees are only read
+	tic = get_seconds();
+	m_thread_contacts.resize(m_workers.size());
+	for (auto& buffer : m_thread_contacts)
+		buffer.clear();
+	m_thread_stats.assign(m_workers.size(), TreeWalkStats());
+	m_workers.run(m_candidates.size(), [&](const int k, const int thread)
+	{
+		Contact contact;
+		contact.a = m_candidates[k].first;
+		contact.b = m_candidates[k].second;
+		const int a = contact.a;
+		const int b = contact.b;
+		const RelativeFrame frame(transforms[a], transforms[b]);
+		const Eigen::Vector3d displacement = frame.vector_a(displacements[b] - displacements[a]);
+		if (m_candidate_fronts[k] ?
+			aabb_trees_time_of_impact(
+				*V[a], *F[a], *trees[a],
+				*V[b], *F[b], *trees[b],
+				frame, displacement, *m_candidate_fronts[k], contact.t, contact.fa, contact.fb,
+				&m_thread_stats[thread]) :
+			aabb_trees_time_of_impact(
+				*V[a], *F[a], *trees[a],
+				*V[b], *F[b], *trees[b],
+				frame, displacement, contact.t, contact.fa, contact.fb,
+				&m_thread_stats[thread]))
+		{
+			m_thread_contacts[thread].push_back(contact);
+		}
+	});
+
+	// Merge in pair order
+	contacts.clear();
+	m_stats.narrow_phase = TreeWalkStats();
+	for (int t = 0; t < m_workers.size(); t++)
+	{
+		contacts.insert(contacts.end(), m_thread_contacts[t].begin(), m_thread_contacts[t].end());
+		m_stats.narrow_phase += m_thread_stats[t];
+	}
+	std::sort(contacts.begin(), contacts.end(), [](const Contact& x, const Contact& y)
+	{
+		return x.a < y.a || (x.a == y.a && x.b < y.b);
+	});
+	m_stats.contacts = contacts.size();
+	m_stats.narrow_phase_seconds = get_seconds() - tic;
+}
@@ -0,0 +1,105 @@
+#ifndef IGL_COLLISION_DETECTOR_H
+#define IGL_COLLISION_DETECTOR_H
+#include "igl_inline.h"
+#include "SweepAndPrune.h"
+#include "TraversalFront.h"
+#include "TreeWalkStats.h"
+#include "WorkerPool.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+namespace igl
+{
+    class FlatBVH;
+    // Continuous collision detection between meshes that translate during
+    // one step of the simulation (a frame of the viewer), as used by the
+    // sandbox and measured by the collision benchmark.
+    //
+    // The broad phase keeps the world bounds of the root box of each tree,
+    // swept over the step, in a SweepAndPrune. Its pairs with at least one
+    // moving object are then walked by aabb_trees_time_of_impact on a
+    // WorkerPool, and the first contact of each pair is reported.
+    //
+    // Pairs stay candidates over many frames while their objects move a
+    // little each time, so each one keeps the TraversalFront where its
+    // last walk stopped and the next walk starts from there. Fronts are
+    // dropped as soon as their pair is no longer a candidate.
+    class CollisionDetector
+    {
+    public:
+        // First contact of objects a < b during the step
+        struct Contact
+        {
+            int a, b;
+            // Fraction of the step at which they touch
+            double t;
+            // Faces of a and b that touch
+            int fa, fb;
+        };
+        // Work of the last detect(), for profiling
+        struct Stats
+        {
+            // Overlapping swept bounds, and those with something moving
+            int broad_phase_pairs;
+            int candidates;
+            int contacts;
+            TreeWalkStats narrow_phase;
+            double broad_phase_seconds;
+            double narrow_phase_seconds;
+        };
+        typedef std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> > Transforms;
+
+        // Inputs:
+        //   num_threads  threads of the narrow phase, 0 for one per
+        //     hardware thread
+        IGL_INLINE explicit CollisionDetector(const int num_threads = 0);
+        // Inputs:
+        //   V, F  #objects lists of meshes, in local coordinates
+        //   trees  #objects list of the trees of the meshes
+        //   transforms  #objects list of transforms from local coordinates
+        //     to the world (Movable::MakeTransScaled())
+        //   displacements  #objects list of the translations of the objects
+        //     in the world over the step, zero for objects at rest
+        // Outputs:
+        //   contacts  first contact of every pair of objects that touch
+        //     during the step, sorted by pair
+        IGL_INLINE void detect(
+            const std::vector<const Eigen::MatrixXd*>& V,
+            const std::vector<const Eigen::MatrixXi*>& F,
+            const std::vector<FlatBVH*>& trees,
+            const Transforms& transforms,
+            const std::vector<Eigen::Vector3d>& displacements,
+            std::vector<Contact>& contacts);
+
+        Stats m_stats;
+        // Whether walks start from the fronts of the last frame rather
+        // than from the roots
+        bool m_use_fronts;
+
+    private:
+        SweepAndPrune m_broad_phase;
+        WorkerPool m_workers;
+        std::vector<Eigen::AlignedBox<double, 3> > m_world_boxes;
+        std::vector<std::pair<int, int> > m_candidates;
+        struct CachedFront
+        {
+            TraversalFront front;
+            // Last detect() in which the pair was a candidate
+            int frame;
+        };
+        std::unordered_map<std::uint64_t, CachedFront> m_fronts;
+        // Front of each candidate
+        std::vector<TraversalFront*> m_candidate_fronts;
+        int m_frame;
+        // Per thread results of the narrow phase
+        std::vector<std::vector<Contact> > m_thread_contacts;
+        std::vector<TreeWalkStats> m_thread_stats;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "CollisionDetector.cpp"
+#endif
+#endif
@@ -0,0 +1,346 @@
+#include "FlatBVH.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	const int num_bins = 16;
+	// Deeper than this splits are at the median, which bounds the depth
+	// (and the stacks of the tree walks) at about 32 + log2(#F)
+	const int max_sah_depth = 32;
+
+	float round_down(const double x)
+	{
+		const float f = float(x);
+		return double(f) > x ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+	}
+
+	float round_up(const double x)
+	{
+		const float f = float(x);
+		return double(f) < x ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+	}
+
+	// Half the surface area of a box, 0 if empty
+	double half_area(const Eigen::AlignedBox<double, 3>& box)
+	{
+		if (box.isEmpty())
+			return 0;
+		const Eigen::Vector3d d = box.sizes();
+		return d(0) * d(1) + d(1) * d(2) + d(2) * d(0);
+	}
+
+	struct Bin
+	{
+		Eigen::AlignedBox<double, 3> box;
+		int count;
+	};
+
+	struct Task
+	{
+		int node;
+		int begin;
+		int end;
+		int depth;
+	};
+
+	int bin_of(const double c, const double min, const double scale)
+	{
+		return std::min(num_bins - 1, int((c - min) * scale));
+	}
+
+	double half_area(const igl::FlatBVH::Node& node)
+	{
+		const double dx = double(node.max[0]) - node.min[0];
+		const double dy = double(node.max[1]) - node.min[1];
+		const double dz = double(node.max[2]) - node.min[2];
+		return dx * dy + dy * dz + dz * dx;
+	}
+
+	// SAH cost of the subtree of node n divided by its area, with a box test
+	// and a triangle test costing the same, from the costs of its children
+	float subtree_cost(const igl::FlatBVH& tree, const std::vector<float>& costs, const int n)
+	{
+		const igl::FlatBVH::Node& node = tree.m_nodes[n];
+		if (node.count > 0)
+			return float(node.count);
+		const int l = node.index;
+		const double area = half_area(node);
+		if (!(area > 0))
+			return 1 + costs[l] + costs[l + 1];
+		return float(1 + (half_area(tree.m_nodes[l]) * costs[l] + half_area(tree.m_nodes[l + 1]) * costs[l + 1]) / area);
+	}
+}
+
+IGL_INLINE void igl::FlatBVH::init(
+	const Eigen::MatrixXd& V,
+	const Eigen::MatrixXi& F,
+	const int max_leaf_size)
+{
+	const int n = F.rows();
+	assert(n > 0 && "FlatBVH of an empty mesh");
+	std::vector<Eigen::AlignedBox<double, 3> > boxes(n);
+	Eigen::MatrixXd centers(n, 3);
+	m_box.setEmpty();
+	for (int f = 0; f < n; f++)
+	{
+		for (int i = 0; i < 3; i++)
+			boxes[f].extend(V.row(F(f, i)).transpose());
+		centers.row(f) = boxes[f].center().transpose();
+		m_box.extend(boxes[f]);
+	}
+	m_primitives.resize(n);
+	for (int f = 0; f < n; f++)
+		m_primitives[f] = f;
+
+	// The root, and an unused node so that siblings start at even indices
+	m_max_leaf_size = max_leaf_size;
+	m_nodes.clear();
+	m_nodes.reserve(2 * n + 1);
+	m_nodes.resize(2);
+	m_nodes[1] = Node();
+	m_nodes[1].count = -1;
+	m_costs.clear();
+	m_unused = 0;
+	m_depth = 0;
+	build(boxes, centers, 0, 0, n, 0);
+}
+
+IGL_INLINE int igl::FlatBVH::refit(
+	const Eigen::MatrixXd& V,
+	const Eigen::MatrixXi& F,
+	const double max_degradation)
+{
+	assert(F.rows() == int(m_primitives.size()) && "FlatBVH refitted to other triangles");
+	// Children before parents
+	std::vector<float> costs(m_nodes.size());
+	m_box.setEmpty();
+	for (int n = int(m_nodes.size()) - 1; n >= 0; n--)
+	{
+		Node& node = m_nodes[n];
+		if (node.count < 0)
+			continue;
+		Eigen::AlignedBox<double, 3> box;
+		if (node.count > 0)
+		{
+			for (int k = 0; k < node.count; k++)
+				for (int i = 0; i < 3; i++)
+					box.extend(V.row(F(m_primitives[node.index + k], i)).transpose());
+			m_box.extend(box);
+			for (int i = 0; i < 3; i++)
+			{
+				node.min[i] = round_down(box.min()(i));
+				node.max[i] = round_up(box.max()(i));
+			}
+		}
+		else
+		{
+			const Node& left = m_nodes[node.index];
+			const Node& right = m_nodes[node.index + 1];
+			for (int i = 0; i < 3; i++)
+			{
+				node.min[i] = std::min(left.min[i], right.min[i]);
+				node.max[i] = std::max(left.max[i], right.max[i]);
+			}
+		}
+		costs[n] = subtree_cost(*this, costs, n);
+	}
+
+	// Highest subtrees that got too expensive
+	std::vector<Task> degraded;
+	std::vector<Task> stack;
+	stack.push_back(Task{ 0, 0, 0, 0 });
+	while (!stack.empty())
+	{
+		const Task task = stack.back();
+		stack.pop_back();
+		const Node& node = m_nodes[task.node];
+		if (node.count > 0)
+			continue;
+		if (costs[task.node] > max_degradation * m_costs[task.node])
+		{
+			if (task.node == 0)
+			{
+				init(V, F, m_max_leaf_size);
+				return 1;
+			}
+			degraded.push_back(task);
+			continue;
+		}
+		stack.push_back(Task{ node.index + 1, 0, 0, task.depth + 1 });
+		stack.push_back(Task{ node.index, 0, 0, task.depth + 1 });
+	}
+	if (degraded.empty())
+		return 0;
+
+	std::vector<Eigen::AlignedBox<double, 3> > boxes(F.rows());
+	Eigen::MatrixXd centers(F.rows(), 3);
+	for (Task& task : degraded)
+	{
+		// Drop the old descendants, noting the triangles they cover: the
+		// ones of the leftmost to the rightmost leaf
+		task.begin = std::numeric_limits<int>::max();
+		task.end = 0;
+		stack.assign(1, task);
+		while (!stack.empty())
+		{
+			const int n = stack.back().node;
+			stack.pop_back();
+			Node& node = m_nodes[n];
+			if (node.count > 0)
+			{
+				task.begin = std::min(task.begin, node.index);
+				task.end = std::max(task.end, node.index + node.count);
+			}
+			else
+			{
+				stack.push_back(Task{ node.index, 0, 0, 0 });
+				stack.push_back(Task{ node.index + 1, 0, 0, 0 });
+			}
+			if (n != task.node)
+			{
+				node.count = -1;
+				m_unused++;
+			}
+		}
+		for (int k = task.begin; k < task.end; k++)
+		{
+			const int f = m_primitives[k];
+			boxes[f].setEmpty();
+			for (int i = 0; i < 3; i++)
+				boxes[f].extend(V.row(F(f, i)).transpose());
+			centers.row(f) = boxes[f].center().transpose();
+		}
+		build(boxes, centers, task.node, task.begin, task.end, task.depth);
+	}
+	// Compact once half the nodes are garbage
+	if (2 * m_unused > int(m_nodes.size()))
+		init(V, F, m_max_leaf_size);
+	return int(degraded.size());
+}
+
+IGL_INLINE void igl::FlatBVH::build(
+	const std::vector<Eigen::AlignedBox<double, 3> >& boxes,
+	const Eigen::MatrixXd& centers,
+	const int root,
+	const int begin,
+	const int end,
+	const int depth)
+{
+	const int first = m_nodes.size();
+	m_version++;
+	std::vector<Task> tasks;
+	tasks.push_back(Task{ root, begin, end, depth });
+	while (!tasks.empty())
+	{
+		const Task task = tasks.back();
+		tasks.pop_back();
+		const int count = task.end - task.begin;
+		Eigen::AlignedBox<double, 3> box;
+		Eigen::AlignedBox<double, 3> center_box;
+		for (int k = task.begin; k < task.end; k++)
+		{
+			box.extend(boxes[m_primitives[k]]);
+			center_box.extend(centers.row(m_primitives[k]).transpose());
+		}
+		Node& node = m_nodes[task.node];
+		for (int i = 0; i < 3; i++)
+		{
+			node.min[i] = round_down(box.min()(i));
+			node.max[i] = round_up(box.max()(i));
+		}
+		node.index = task.begin;
+		node.count = count;
+		m_depth = std::max(m_depth, task.depth);
+		if (count == 1)
+			continue;
+
+		// Best binned SAH split: cost of a split is the area of each side
+		// times its number of triangles
+		double best_cost = std::numeric_limits<double>::infinity();
+		int best_axis = -1;
+		int best_bin = 0;
+		if (task.depth < max_sah_depth)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const double extent = center_box.max()(axis) - center_box.min()(axis);
+				if (!(extent > 0))
+					continue;
+				const double scale = num_bins / extent;
+				Bin bins[num_bins];
+				for (Bin& bin : bins)
+					bin.count = 0;
+				for (int k = task.begin; k < task.end; k++)
+				{
+					const int f = m_primitives[k];
+					Bin& bin = bins[bin_of(centers(f, axis), center_box.min()(axis), scale)];
+					bin.box.extend(boxes[f]);
+					bin.count++;
+				}
+				// Right sides swept from the end, left sides from the start
+				double right_area[num_bins];
+				int right_count[num_bins];
+				Eigen::AlignedBox<double, 3> right;
+				int right_n = 0;
+				for (int b = num_bins - 1; b > 0; b--)
+				{
+					right.extend(bins[b].box);
+					right_n += bins[b].count;
+					right_area[b] = half_area(right);
+					right_count[b] = right_n;
+				}
+				Eigen::AlignedBox<double, 3> left;
+				int left_n = 0;
+				for (int b = 1; b < num_bins; b++)
+				{
+					left.extend(bins[b - 1].box);
+					left_n += bins[b - 1].count;
+					const double cost = half_area(left) * left_n + right_area[b] * right_count[b];
+					if (left_n > 0 && right_count[b] > 0 && cost < best_cost)
+					{
+						best_cost = cost;
+						best_axis = axis;
+						best_bin = b;
+					}
+				}
+			}
+		}
+		// A leaf costs a test per triangle, a split one box test more
+		if (count <= m_max_leaf_size && !(best_cost < half_area(box) * (count - 1)))
+			continue;
+
+		int middle;
+		if (best_axis >= 0)
+		{
+			const double min = center_box.min()(best_axis);
+			const double scale = num_bins / (center_box.max()(best_axis) - min);
+			middle = int(std::partition(m_primitives.begin() + task.begin, m_primitives.begin() + task.end,
+				[&](const int f) { return bin_of(centers(f, best_axis), min, scale) < best_bin; }) - m_primitives.begin());
+		}
+		else
+		{
+			// Median of the centers along the longest side
+			int axis;
+			center_box.sizes().maxCoeff(&axis);
+			middle = task.begin + count / 2;
+			std::nth_element(m_primitives.begin() + task.begin, m_primitives.begin() + middle, m_primitives.begin() + task.end,
+				[&](const int a, const int b) { return centers(a, axis) < centers(b, axis); });
+		}
+
+		const int left = m_nodes.size();
+		m_nodes.resize(left + 2);
+		m_nodes[task.node].index = left;
+		m_nodes[task.node].count = 0;
+		tasks.push_back(Task{ left + 1, middle, task.end, task.depth + 1 });
+		tasks.push_back(Task{ left, task.begin, middle, task.depth + 1 });
+	}
+
+	// Costs of the new nodes, children first
+	m_costs.resize(m_nodes.size());
+	for (int n = int(m_nodes.size()) - 1; n >= first; n--)
+		m_costs[n] = subtree_cost(*this, m_costs, n);
+	m_costs[root] = subtree_cost(*this, m_costs, root);
+}
@@ -0,0 +1,151 @@
+#ifndef IGL_FLAT_BVH_H
+#define IGL_FLAT_BVH_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+namespace igl
+{
+    // Bounding volume hierarchy of the triangles of a mesh stored as one
+    // array of 32 byte nodes with single precision boxes, as an alternative
+    // to the pointer linked, double precision igl::AABB for collision
+    // queries (see aabb_trees_intersect and aabb_trees_time_of_impact,
+    // which accept both).
+    //
+    // Node 0 is the root and children are stored in pairs at even indices,
+    // so with the array aligned to 64 bytes two siblings share one cache
+    // line. Leaves hold up to max_leaf_size triangles. Splits are chosen by
+    // the surface area heuristic over 16 bins per axis. Boxes are rounded
+    // outwards to floats, so they still contain their triangles.
+    //
+    // When the mesh deforms, refit() moves the boxes with the vertices
+    // instead of building again, and rebuilds only the subtrees it made
+    // much worse.
+    //
+    // Nodes are accessed through the same small interface as AABBNodes.
+    class FlatBVH
+    {
+    public:
+        struct Node
+        {
+            float min[3];
+            // Internal: index of the left child, the right one follows.
+            // Leaf: first of its triangles in m_primitives.
+            int index;
+            float max[3];
+            // Number of triangles of a leaf, 0 for internal nodes
+            int count;
+        };
+        // Allocates at 64 byte boundaries
+        template <typename T>
+        struct CacheLineAllocator
+        {
+            typedef T value_type;
+            CacheLineAllocator() {}
+            template <typename U>
+            CacheLineAllocator(const CacheLineAllocator<U>&) {}
+            T* allocate(const std::size_t n)
+            {
+                char* raw = static_cast<char*>(::operator new(n * sizeof(T) + 64 + sizeof(void*)));
+                char* p = raw + sizeof(void*);
+                p += (64 - reinterpret_cast<std::uintptr_t>(p) % 64) % 64;
+                reinterpret_cast<void**>(p)[-1] = raw;
+                return reinterpret_cast<T*>(p);
+            }
+            void deallocate(T* p, const std::size_t)
+            {
+                ::operator delete(reinterpret_cast<void**>(p)[-1]);
+            }
+            template <typename U>
+            bool operator==(const CacheLineAllocator<U>&) const { return true; }
+            template <typename U>
+            bool operator!=(const CacheLineAllocator<U>&) const { return false; }
+        };
+
+        FlatBVH() : m_depth(0), m_unused(0), m_max_leaf_size(4), m_version(0) {}
+        // Build the hierarchy
+        //
+        // Inputs:
+        //   V  #V by 3 list of vertex positions
+        //   F  #F by 3 list of triangles
+        //   max_leaf_size  largest number of triangles per leaf
+        IGL_INLINE void init(
+            const Eigen::MatrixXd& V,
+            const Eigen::MatrixXi& F,
+            const int max_leaf_size = 4);
+        // Move the boxes to new positions of the vertices in one bottom up
+        // pass over the nodes (children are stored after their parent). The
+        // tree keeps its topology, so its quality degrades as the mesh
+        // deforms: the subtrees whose SAH cost, relative to their area,
+        // grew more than max_degradation times since they were built are
+        // built again, and the whole tree when that is the root.
+        //
+        // Inputs:
+        //   V  #V by 3 list of new vertex positions
+        //   F  #F by 3 list of triangles, the same as given to init
+        //   max_degradation  largest accepted ratio of the cost of a subtree
+        //     to its cost when built
+        // Returns the number of subtrees built again
+        IGL_INLINE int refit(
+            const Eigen::MatrixXd& V,
+            const Eigen::MatrixXi& F,
+            const double max_degradation = 1.5);
+
+        typedef int NodeRef;
+        NodeRef root() const { return 0; }
+        bool is_leaf(const NodeRef n) const { return m_nodes[n].count > 0; }
+        NodeRef left(const NodeRef n) const { return m_nodes[n].index; }
+        NodeRef right(const NodeRef n) const { return m_nodes[n].index + 1; }
+        Eigen::AlignedBox<double, 3> box(const NodeRef n) const
+        {
+            const Node& node = m_nodes[n];
+            return Eigen::AlignedBox<double, 3>(
+                Eigen::Vector3d(node.min[0], node.min[1], node.min[2]),
+                Eigen::Vector3d(node.max[0], node.max[1], node.max[2]));
+        }
+        // Triangles of a leaf
+        int size(const NodeRef n) const { return m_nodes[n].count; }
+        int primitive(const NodeRef n, const int k) const { return m_primitives[m_nodes[n].index + k]; }
+
+        std::vector<Node, CacheLineAllocator<Node> > m_nodes;
+        // Triangle indices, grouped by leaf
+        std::vector<int> m_primitives;
+        // Exact bounds of the whole mesh, as igl::AABB::m_box
+        Eigen::AlignedBox<double, 3> m_box;
+        // Number of levels below the root
+        int m_depth;
+        // SAH cost of the subtree of each node when it was built, divided
+        // by the area of the node
+        std::vector<float> m_costs;
+        // Nodes left behind by partial rebuilds (with count -1), until the
+        // next full one
+        int m_unused;
+        int m_max_leaf_size;
+        // Changes whenever nodes are built, by init or refit, so that
+        // references to the old ones can be dropped (see TraversalFront)
+        int m_version;
+
+    private:
+        // Build the subtree of root over m_primitives[begin, end), appending
+        // its descendants to m_nodes
+        //
+        // Inputs:
+        //   boxes  #F list of exact bounds of the triangles
+        //   centers  #F by 3 list of the centers of those boxes
+        IGL_INLINE void build(
+            const std::vector<Eigen::AlignedBox<double, 3> >& boxes,
+            const Eigen::MatrixXd& centers,
+            const int root,
+            const int begin,
+            const int end,
+            const int depth);
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "FlatBVH.cpp"
+#endif
+#endif
@@ -0,0 +1,141 @@
+#include "RelativeFrame.h"
+#include <algorithm>
+#include <cmath>
+
+IGL_INLINE void igl::RelativeFrame::set(const Eigen::Matrix4d& TA, const Eigen::Matrix4d& TB)
+{
+	const Eigen::Matrix3d LA = TA.topLeftCorner<3, 3>();
+	const Eigen::Matrix3d LB = TB.topLeftCorner<3, 3>();
+	scale_a = LA.colwise().norm().transpose();
+	scale_b = LB.colwise().norm().transpose();
+	const Eigen::Matrix3d RA = LA * scale_a.cwiseInverse().asDiagonal();
+	const Eigen::Matrix3d RB = LB * scale_b.cwiseInverse().asDiagonal();
+	rotation_a = RA;
+	R = RA.transpose() * RB;
+	// The epsilon keeps the cross product axes from reporting a separation
+	// when two edges are (nearly) parallel and their cross product vanishes
+	absR = R.cwiseAbs().array() + 1e-12;
+	K = RA.transpose() * LB;
+	d = RA.transpose() * (TB.topRightCorner<3, 1>() - TA.topRightCorner<3, 1>());
+}
+
+IGL_INLINE bool igl::RelativeFrame::overlap(
+	const Eigen::AlignedBox<double, 3>& a,
+	const Eigen::AlignedBox<double, 3>& b) const
+{
+	using std::abs;
+	// Half sizes and center of b in A's frame, where A's box is axis aligned
+	const Eigen::Vector3d ha = 0.5 * (a.max() - a.min()).cwiseProduct(scale_a);
+	const Eigen::Vector3d hb = 0.5 * (b.max() - b.min()).cwiseProduct(scale_b);
+	const Eigen::Vector3d T =
+		K * (0.5 * (b.min() + b.max())) + d - (0.5 * (a.min() + a.max())).cwiseProduct(scale_a);
+
+	// L = A0, A1, A2
+	for (int i = 0; i < 3; i++)
+		if (abs(T(i)) > ha(i) + hb.dot(absR.row(i)))
+			return false;
+	// L = B0, B1, B2
+	for (int j = 0; j < 3; j++)
+		if (abs(T.dot(R.col(j))) > ha.dot(absR.col(j)) + hb(j))
+			return false;
+	// L = Ai x Bj
+	if (abs(T(2) * R(1, 0) - T(1) * R(2, 0)) > ha(1) * absR(2, 0) + ha(2) * absR(1, 0) + hb(1) * absR(0, 2) + hb(2) * absR(0, 1))
+		return false;
+	if (abs(T(2) * R(1, 1) - T(1) * R(2, 1)) > ha(1) * absR(2, 1) + ha(2) * absR(1, 1) + hb(0) * absR(0, 2) + hb(2) * absR(0, 0))
+		return false;
+	if (abs(T(2) * R(1, 2) - T(1) * R(2, 2)) > ha(1) * absR(2, 2) + ha(2) * absR(1, 2) + hb(0) * absR(0, 1) + hb(1) * absR(0, 0))
+		return false;
+	if (abs(T(0) * R(2, 0) - T(2) * R(0, 0)) > ha(0) * absR(2, 0) + ha(2) * absR(0, 0) + hb(1) * absR(1, 2) + hb(2) * absR(1, 1))
+		return false;
+	if (abs(T(0) * R(2, 1) - T(2) * R(0, 1)) > ha(0) * absR(2, 1) + ha(2) * absR(0, 1) + hb(0) * absR(1, 2) + hb(2) * absR(1, 0))
+		return false;
+	if (abs(T(0) * R(2, 2) - T(2) * R(0, 2)) > ha(0) * absR(2, 2) + ha(2) * absR(0, 2) + hb(0) * absR(1, 1) + hb(1) * absR(1, 0))
+		return false;
+	if (abs(T(1) * R(0, 0) - T(0) * R(1, 0)) > ha(0) * absR(1, 0) + ha(1) * absR(0, 0) + hb(1) * absR(2, 2) + hb(2) * absR(2, 1))
+		return false;
+	if (abs(T(1) * R(0, 1) - T(0) * R(1, 1)) > ha(0) * absR(1, 1) + ha(1) * absR(0, 1) + hb(0) * absR(2, 2) + hb(2) * absR(2, 0))
+		return false;
+	if (abs(T(1) * R(0, 2) - T(0) * R(1, 2)) > ha(0) * absR(1, 2) + ha(1) * absR(0, 2) + hb(0) * absR(2, 1) + hb(1) * absR(2, 0))
+		return false;
+	return true;
+}
+
+IGL_INLINE bool igl::RelativeFrame::overlap(
+	const Eigen::AlignedBox<double, 3>& a,
+	const Eigen::AlignedBox<double, 3>& b,
+	const Eigen::Vector3d& displacement,
+	double& t0,
+	double& t1) const
+{
+	int axis = -1;
+	return overlap(a, b, displacement, t0, t1, axis);
+}
+
+IGL_INLINE bool igl::RelativeFrame::overlap(
+	const Eigen::AlignedBox<double, 3>& a,
+	const Eigen::AlignedBox<double, 3>& b,
+	const Eigen::Vector3d& displacement,
+	double& t0,
+	double& t1,
+	int& axis) const
+{
+	const Eigen::Vector3d ha = 0.5 * (a.max() - a.min()).cwiseProduct(scale_a);
+	const Eigen::Vector3d hb = 0.5 * (b.max() - b.min()).cwiseProduct(scale_b);
+	const Eigen::Vector3d T =
+		K * (0.5 * (b.min() + b.max())) + d - (0.5 * (a.min() + a.max())).cwiseProduct(scale_a);
+	const Eigen::Vector3d& D = displacement;
+	// Along an axis the centers are s + v t apart and the boxes overlap
+	// while that is within r
+	const auto clip = [&](const int k)
+	{
+		double s, v, r;
+		if (k < 3)
+		{
+			// L = Ak
+			s = T(k);
+			v = D(k);
+			r = ha(k) + hb.dot(absR.row(k));
+		}
+		else if (k < 6)
+		{
+			// L = Bj
+			const int j = k - 3;
+			s = T.dot(R.col(j));
+			v = D.dot(R.col(j));
+			r = ha.dot(absR.col(j)) + hb(j);
+		}
+		else
+		{
+			// L = Ai x Bj
+			const int i = (k - 6) / 3;
+			const int j = (k - 6) % 3;
+			const int i1 = (i + 1) % 3;
+			const int i2 = (i + 2) % 3;
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+			s = T(i2) * R(i1, j) - T(i1) * R(i2, j);
+			v = D(i2) * R(i1, j) - D(i1) * R(i2, j);
+			r = ha(i1) * absR(i2, j) + ha(i2) * absR(i1, j) + hb(j1) * absR(i, j2) + hb(j2) * absR(i, j1);
+		}
+		if (v == 0)
+			return std::abs(s) <= r;
+		double enter = (-r - s) / v;
+		double leave = (r - s) / v;
+		if (enter > leave)
+			std::swap(enter, leave);
+		t0 = std::max(t0, enter);
+		t1 = std::min(t1, leave);
+		return t0 <= t1;
+	};
+	if (axis >= 0 && !clip(axis))
+		return false;
+	for (int k = 0; k < 15; k++)
+	{
+		if (k != axis && !clip(k))
+		{
+			axis = k;
+			return false;
+		}
+	}
+	return true;
+}
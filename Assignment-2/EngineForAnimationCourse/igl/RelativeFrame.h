@@ -0,0 +1,95 @@
+#ifndef IGL_RELATIVE_FRAME_H
+#define IGL_RELATIVE_FRAME_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+namespace igl
+{
+    // Pose of an object B relative to an object A, for separating axis
+    // tests between the boxes of their AABB trees. Each object is placed in
+    // the world by an affine transform whose linear part is a rotation times
+    // a per axis scale (Movable::MakeTransScaled()), so a box of either tree
+    // is an oriented box in the world.
+    //
+    // Everything that only depends on the two transforms (the rotation of B
+    // in A's frame, its absolute value, the translation and the scales) is
+    // computed once by set(), so that testing a pair of boxes costs a 3 by 3
+    // product for the centers and the 15 axis test.
+    class RelativeFrame
+    {
+    public:
+        RelativeFrame() {}
+        RelativeFrame(const Eigen::Matrix4d& TA, const Eigen::Matrix4d& TB) { set(TA, TB); }
+        // Inputs:
+        //   TA, TB  4 by 4 transforms from the local coordinates of A and B
+        //     to the world
+        IGL_INLINE void set(const Eigen::Matrix4d& TA, const Eigen::Matrix4d& TB);
+        // Whether two boxes, given in the local coordinates of A and B,
+        // overlap in the world
+        IGL_INLINE bool overlap(
+            const Eigen::AlignedBox<double, 3>& a,
+            const Eigen::AlignedBox<double, 3>& b) const;
+        // Narrows [t0, t1] to the times t at which box b, displaced by
+        // t * displacement, overlaps box a (the 15 axes are the same at all
+        // times, so the result is the intersection of one interval per axis)
+        //
+        // Inputs:
+        //   a, b  boxes in the local coordinates of A and B
+        //   displacement  motion of B relative to A, in A's frame
+        //   t0, t1  time window
+        // Outputs:
+        //   t0, t1  narrowed window
+        // Returns false iff the window became empty
+        IGL_INLINE bool overlap(
+            const Eigen::AlignedBox<double, 3>& a,
+            const Eigen::AlignedBox<double, 3>& b,
+            const Eigen::Vector3d& displacement,
+            double& t0,
+            double& t1) const;
+        // Same, testing first the axis that separated the boxes the last
+        // time, which most likely still does when they moved little. Axes
+        // are numbered 0 to 2 for A's, 3 to 5 for B's and 6 + 3 i + j for
+        // the cross product of A's axis i and B's axis j.
+        //
+        // Inputs:
+        //   axis  axis to test first, or -1
+        // Outputs:
+        //   axis  axis that emptied the window, unchanged if it did not
+        IGL_INLINE bool overlap(
+            const Eigen::AlignedBox<double, 3>& a,
+            const Eigen::AlignedBox<double, 3>& b,
+            const Eigen::Vector3d& displacement,
+            double& t0,
+            double& t1,
+            int& axis) const;
+        // A world vector in A's frame
+        Eigen::Vector3d vector_a(const Eigen::Vector3d& v) const { return rotation_a.transpose() * v; }
+        // A point of A resp. B in A's frame, where the exact tests are done
+        Eigen::Vector3d point_a(const Eigen::Vector3d& x) const { return x.cwiseProduct(scale_a); }
+        Eigen::Vector3d point_b(const Eigen::Vector3d& x) const { return K * x + d; }
+        // Squared world radius of a box of A resp. B, to compare sizes
+        double radius_a(const Eigen::AlignedBox<double, 3>& a) const
+        {
+            return a.sizes().cwiseProduct(scale_a).squaredNorm();
+        }
+        double radius_b(const Eigen::AlignedBox<double, 3>& b) const
+        {
+            return b.sizes().cwiseProduct(scale_b).squaredNorm();
+        }
+
+        // Rotation of B's axes in A's (unscaled) frame, and |R| + epsilon
+        Eigen::Matrix3d R, absR;
+        // Local coordinates of B to A's frame: x -> K x + d
+        Eigen::Matrix3d K;
+        Eigen::Vector3d d;
+        // Rotation of A in the world
+        Eigen::Matrix3d rotation_a;
+        // Per axis scales of A and B
+        Eigen::Vector3d scale_a, scale_b;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "RelativeFrame.cpp"
+#endif
+#endif
@@ -0,0 +1,104 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+
+namespace
+{
+	bool boxes_overlap(const igl::SweepAndPrune::Box& a, const igl::SweepAndPrune::Box& b)
+	{
+		return (a.min().array() <= b.max().array()).all() && (b.min().array() <= a.max().array()).all();
+	}
+}
+
+IGL_INLINE void igl::SweepAndPrune::update(const std::vector<Box>& boxes)
+{
+	if (m_axes[0].size() != 2 * boxes.size())
+	{
+		rebuild(boxes);
+	}
+	else
+	{
+		for (int axis = 0; axis < 3; axis++)
+			sort_axis(boxes, axis);
+	}
+	m_pairs.clear();
+	m_pairs.reserve(m_overlapping.size());
+	for (const std::uint64_t k : m_overlapping)
+		m_pairs.emplace_back(int(k >> 32), int(k & 0xffffffff));
+}
+
+IGL_INLINE void igl::SweepAndPrune::clear()
+{
+	for (auto& axis : m_axes)
+		axis.clear();
+	m_overlapping.clear();
+	m_pairs.clear();
+}
+
+IGL_INLINE void igl::SweepAndPrune::rebuild(const std::vector<Box>& boxes)
+{
+	const int n = boxes.size();
+	for (int axis = 0; axis < 3; axis++)
+	{
+		std::vector<EndPoint>& points = m_axes[axis];
+		points.resize(2 * n);
+		for (int i = 0; i < n; i++)
+		{
+			points[2 * i] = EndPoint{ boxes[i].min()(axis), 2 * i };
+			points[2 * i + 1] = EndPoint{ boxes[i].max()(axis), 2 * i + 1 };
+		}
+		std::sort(points.begin(), points.end());
+	}
+	// Sweep along x, checking the other axes for boxes open at the same time
+	m_overlapping.clear();
+	std::vector<int> open;
+	std::vector<int> slot(n, -1);
+	for (const EndPoint& p : m_axes[0])
+	{
+		const int i = p.box();
+		if (p.is_max())
+		{
+			slot[open.back()] = slot[i];
+			open[slot[i]] = open.back();
+			open.pop_back();
+			continue;
+		}
+		for (const int j : open)
+			if (boxes_overlap(boxes[i], boxes[j]))
+				m_overlapping.insert(key(i, j));
+		slot[i] = open.size();
+		open.push_back(i);
+	}
+}
+
+IGL_INLINE void igl::SweepAndPrune::sort_axis(const std::vector<Box>& boxes, const int axis)
+{
+	std::vector<EndPoint>& points = m_axes[axis];
+	for (EndPoint& p : points)
+		p.value = p.is_max() ? boxes[p.box()].max()(axis) : boxes[p.box()].min()(axis);
+	// Insertion sort: each out of order pair of end points is swapped once,
+	// so a min passing a max here means the two boxes now overlap along
+	// this axis, and a max passing a min that they stopped overlapping
+	for (int i = 1; i < int(points.size()); i++)
+	{
+		const EndPoint p = points[i];
+		int j = i;
+		for (; j > 0 && p < points[j - 1]; j--)
+		{
+			const EndPoint& q = points[j - 1];
+			if (p.is_max() != q.is_max())
+			{
+				if (!p.is_max())
+				{
+					if (boxes_overlap(boxes[p.box()], boxes[q.box()]))
+						m_overlapping.insert(key(p.box(), q.box()));
+				}
+				else
+				{
+					m_overlapping.erase(key(p.box(), q.box()));
+				}
+			}
+			points[j] = q;
+		}
+		points[j] = p;
+	}
+}
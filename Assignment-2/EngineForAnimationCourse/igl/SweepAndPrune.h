@@ -0,0 +1,66 @@
+#ifndef IGL_SWEEP_AND_PRUNE_H
+#define IGL_SWEEP_AND_PRUNE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+namespace igl
+{
+    // Broad phase collision detection by incremental sweep and prune: the
+    // end points of a set of moving boxes are kept sorted along x, y and z
+    // together with the set of overlapping pairs of boxes.
+    //
+    // Each update() re-sorts the three lists by insertion sort, which is
+    // about linear when the boxes move little between calls, and every swap
+    // of a min past a max (or back) adds (or drops) the pair it concerns.
+    // Only the first call, or a call with a different number of boxes,
+    // sorts from scratch.
+    //
+    // Boxes that touch count as overlapping.
+    class SweepAndPrune
+    {
+    public:
+        typedef Eigen::AlignedBox<double, 3> Box;
+        // Inputs:
+        //   boxes  #boxes list of boxes, in the same order at every call
+        IGL_INLINE void update(const std::vector<Box>& boxes);
+        // Pairs (i, j) with i < j of overlapping boxes, in no particular
+        // order, as of the last update()
+        const std::vector<std::pair<int, int> >& pairs() const { return m_pairs; }
+        // Forget all boxes
+        IGL_INLINE void clear();
+
+    private:
+        struct EndPoint
+        {
+            double value;
+            // box index times 2, plus 1 for a max
+            int tag;
+            int box() const { return tag >> 1; }
+            bool is_max() const { return tag & 1; }
+            // On ties mins come first, so that touching boxes overlap
+            bool operator<(const EndPoint& other) const
+            {
+                return value < other.value || (value == other.value && tag % 2 < other.tag % 2);
+            }
+        };
+        static std::uint64_t key(const int i, const int j)
+        {
+            return i < j ? (std::uint64_t(i) << 32) | std::uint32_t(j) : (std::uint64_t(j) << 32) | std::uint32_t(i);
+        }
+        IGL_INLINE void rebuild(const std::vector<Box>& boxes);
+        IGL_INLINE void sort_axis(const std::vector<Box>& boxes, const int axis);
+
+        std::vector<EndPoint> m_axes[3];
+        std::unordered_set<std::uint64_t> m_overlapping;
+        std::vector<std::pair<int, int> > m_pairs;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SweepAndPrune.cpp"
+#endif
+#endif
@@ -0,0 +1,44 @@
+#include "TraversalFront.h"
+#include "FlatBVH.h"
+
+IGL_INLINE void igl::TraversalFront::prepare(const FlatBVH& A, const FlatBVH& B)
+{
+	if (!m_nodes.empty() && m_A == &A && m_B == &B && m_version_a == A.m_version && m_version_b == B.m_version)
+		return;
+	m_A = &A;
+	m_B = &B;
+	m_version_a = A.m_version;
+	m_version_b = B.m_version;
+	m_merged = 0;
+	m_nodes.clear();
+	Node root;
+	root.a = A.root();
+	root.b = B.root();
+	root.parent = -1;
+	root.child = -1;
+	root.axis = -1;
+	root.apart = 0;
+	m_nodes.push_back(root);
+}
+
+IGL_INLINE void igl::TraversalFront::compact()
+{
+	// Copy breadth first, which keeps parents before their children
+	std::vector<Node> old;
+	old.swap(m_nodes);
+	m_nodes.reserve(old.size() - m_merged);
+	m_nodes.push_back(old[0]);
+	for (int i = 0; i < int(m_nodes.size()); i++)
+	{
+		const int child = m_nodes[i].child;
+		if (child < 0)
+			continue;
+		m_nodes[i].child = m_nodes.size();
+		for (int k = 0; k < 2; k++)
+		{
+			m_nodes.push_back(old[child + k]);
+			m_nodes.back().parent = i;
+		}
+	}
+	m_merged = 0;
+}
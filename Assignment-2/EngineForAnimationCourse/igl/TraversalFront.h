@@ -0,0 +1,55 @@
+#ifndef IGL_TRAVERSAL_FRONT_H
+#define IGL_TRAVERSAL_FRONT_H
+#include "igl_inline.h"
+#include <vector>
+namespace igl
+{
+    class FlatBVH;
+    // Where the last walk over a pair of FlatBVH trees stopped (see
+    // aabb_trees_time_of_impact): the pairs of nodes it did not split,
+    // because their boxes were apart or both were leaves, together with the
+    // pairs they were split from.
+    //
+    // Objects move little from one frame to the next, so the next walk
+    // starts from that front instead of the roots: it only splits the pairs
+    // that now overlap, and merges back into their parent the pairs that
+    // stayed apart for a while. Each pair also keeps the axis that last
+    // separated its boxes, which is tested first the next time.
+    class TraversalFront
+    {
+    public:
+        struct Node
+        {
+            // Nodes of A and B
+            int a, b;
+            // Pair this one was split from, -1 for the roots
+            int parent;
+            // First of the two pairs this one was split into, the other
+            // follows; -1 for pairs of the front and -2 for merged ones
+            int child;
+            // Last separating axis (see RelativeFrame::overlap), or -1
+            int axis;
+            // Number of walks in a row that found the boxes apart
+            int apart;
+        };
+        TraversalFront() : m_A(nullptr), m_B(nullptr), m_version_a(0), m_version_b(0), m_merged(0) {}
+        // Start again from the roots if the trees are not the ones of the
+        // last walk, or have been built again since
+        IGL_INLINE void prepare(const FlatBVH& A, const FlatBVH& B);
+        // Free the storage of merged pairs
+        IGL_INLINE void compact();
+
+        // Parents are stored before their children
+        std::vector<Node> m_nodes;
+        const FlatBVH* m_A;
+        const FlatBVH* m_B;
+        int m_version_a, m_version_b;
+        // Merged pairs in m_nodes
+        int m_merged;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "TraversalFront.cpp"
+#endif
+#endif
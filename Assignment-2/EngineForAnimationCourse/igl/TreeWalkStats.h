@@ -0,0 +1,22 @@
+#ifndef IGL_TREE_WALK_STATS_H
+#define IGL_TREE_WALK_STATS_H
+namespace igl
+{
+    // Work done by walks over pairs of trees (see
+    // aabb_trees_time_of_impact), for profiling
+    struct TreeWalkStats
+    {
+        TreeWalkStats() : box_tests(0), triangle_tests(0) {}
+        TreeWalkStats& operator+=(const TreeWalkStats& other)
+        {
+            box_tests += other.box_tests;
+            triangle_tests += other.triangle_tests;
+            return *this;
+        }
+        // Pairs of nodes whose boxes were tested
+        long long box_tests;
+        // Pairs of triangles tested in leaves
+        long long triangle_tests;
+    };
+}
+#endif
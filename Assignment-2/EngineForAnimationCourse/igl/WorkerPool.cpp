@@ -0,0 +1,89 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+IGL_INLINE igl::WorkerPool::WorkerPool(const int num_threads) :
+	m_func(NULL),
+	m_n(0),
+	m_grain(1),
+	m_next(0),
+	m_busy(0),
+	m_generation(0),
+	m_stop(false)
+{
+	const int n = num_threads > 0 ? num_threads : std::max(1, int(std::thread::hardware_concurrency()));
+	for (int t = 1; t < n; t++)
+		m_threads.emplace_back(&WorkerPool::work, this, t);
+}
+
+IGL_INLINE igl::WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_start.notify_all();
+	for (std::thread& thread : m_threads)
+		thread.join();
+}
+
+IGL_INLINE void igl::WorkerPool::run(
+	const int n,
+	const std::function<void(int, int)>& func,
+	const int grain)
+{
+	if (n <= 0)
+		return;
+	if (m_threads.empty() || n <= grain)
+	{
+		for (int i = 0; i < n; i++)
+			func(i, 0);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_func = &func;
+		m_n = n;
+		m_grain = std::max(1, grain);
+		m_next = 0;
+		m_busy = m_threads.size();
+		m_generation++;
+	}
+	m_start.notify_all();
+	drain(0);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this] { return m_busy == 0; });
+}
+
+IGL_INLINE void igl::WorkerPool::work(const int t)
+{
+	unsigned seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_start.wait(lock, [this, seen] { return m_stop || m_generation != seen; });
+			if (m_stop)
+				return;
+			seen = m_generation;
+		}
+		drain(t);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_busy == 0)
+				m_done.notify_one();
+		}
+	}
+}
+
+IGL_INLINE void igl::WorkerPool::drain(const int t)
+{
+	for (;;)
+	{
+		const int begin = m_next.fetch_add(m_grain);
+		if (begin >= m_n)
+			return;
+		const int end = std::min(begin + m_grain, m_n);
+		for (int i = begin; i < end; i++)
+			(*m_func)(i, t);
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef IGL_WORKER_POOL_H
+#define IGL_WORKER_POOL_H
+#include "igl_inline.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace igl
+{
+    // Fixed set of threads for loops that run every frame, where starting
+    // threads at each call (as parallel_for does) would cost more than the
+    // work. Iterations are handed out dynamically, so loops whose
+    // iterations differ much in cost stay balanced, and the calling thread
+    // takes part in the work.
+    class WorkerPool
+    {
+    public:
+        // Inputs:
+        //   num_threads  number of threads including the caller, 0 for one
+        //     per hardware thread
+        IGL_INLINE explicit WorkerPool(const int num_threads = 0);
+        IGL_INLINE ~WorkerPool();
+        // Number of threads including the caller
+        int size() const { return int(m_threads.size()) + 1; }
+        // Call func(i, t) for all i in [0, n), where t in [0, size()) is
+        // the thread running the call, and return when all are done. The
+        // caller is thread 0.
+        //
+        // Inputs:
+        //   n  number of iterations
+        //   func  loop body
+        //   grain  number of consecutive iterations handed out at once
+        IGL_INLINE void run(
+            const int n,
+            const std::function<void(int, int)>& func,
+            const int grain = 1);
+
+    private:
+        WorkerPool(const WorkerPool&);
+        WorkerPool& operator=(const WorkerPool&);
+        IGL_INLINE void work(const int t);
+        IGL_INLINE void drain(const int t);
+
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        // Current loop
+        const std::function<void(int, int)>* m_func;
+        int m_n;
+        int m_grain;
+        std::atomic<int> m_next;
+        // Workers that have not finished the current loop
+        int m_busy;
+        // Incremented at each loop, so that workers see new ones
+        unsigned m_generation;
+        bool m_stop;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "WorkerPool.cpp"
+#endif
+#endif
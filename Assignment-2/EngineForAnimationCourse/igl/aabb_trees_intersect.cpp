@@ -0,0 +1,138 @@
+#include "aabb_trees_intersect.h"
+#include "AABBNodes.h"
+#include "FlatBVH.h"
+#include "RelativeFrame.h"
+#include "tri_tri_intersect.h"
+#include <cassert>
+
+namespace
+{
+	// Exact tests of a batch of leaf pairs, appended to contacts. Returns
+	// whether to stop.
+	bool test_leaves(
+		const Eigen::MatrixXd& VA,
+		const Eigen::MatrixXi& FA,
+		const Eigen::MatrixXd& VB,
+		const Eigen::MatrixXi& FB,
+		const igl::RelativeFrame& frame,
+		const std::pair<int, int>* leaves,
+		const int num_leaves,
+		const bool first_hit_only,
+		std::vector<std::pair<int, int> >& contacts)
+	{
+		for (int i = 0; i < num_leaves; i++)
+		{
+			const int fa = leaves[i].first;
+			const int fb = leaves[i].second;
+			if (igl::tri_tri_intersect(
+				frame.point_a(VA.row(FA(fa, 0)).transpose()),
+				frame.point_a(VA.row(FA(fa, 1)).transpose()),
+				frame.point_a(VA.row(FA(fa, 2)).transpose()),
+				frame.point_b(VB.row(FB(fb, 0)).transpose()),
+				frame.point_b(VB.row(FB(fb, 1)).transpose()),
+				frame.point_b(VB.row(FB(fb, 2)).transpose())))
+			{
+				contacts.push_back(leaves[i]);
+				if (first_hit_only)
+					return true;
+			}
+		}
+		return false;
+	}
+
+	template <typename Nodes>
+	bool intersect(
+		const Eigen::MatrixXd& VA,
+		const Eigen::MatrixXi& FA,
+		const Nodes& A,
+		const Eigen::MatrixXd& VB,
+		const Eigen::MatrixXi& FB,
+		const Nodes& B,
+		const igl::RelativeFrame& frame,
+		const bool first_hit_only,
+		std::vector<std::pair<int, int> >& contacts)
+	{
+		typedef typename Nodes::NodeRef NodeRef;
+		typedef std::pair<NodeRef, NodeRef> Pair;
+		// Every pop pushes at most two pairs that are one level deeper in
+		// one of the trees, so 128 pairs cover trees of depth 64 each
+		const int max_stack = 128;
+		Pair stack[max_stack];
+		int top = 0;
+		const int max_leaves = 64;
+		std::pair<int, int> leaves[max_leaves];
+		int num_leaves = 0;
+		contacts.clear();
+		stack[top++] = Pair(A.root(), B.root());
+		while (top > 0)
+		{
+			const NodeRef a = stack[--top].first;
+			const NodeRef b = stack[top].second;
+			const Eigen::AlignedBox<double, 3>& box_a = A.box(a);
+			const Eigen::AlignedBox<double, 3>& box_b = B.box(b);
+			if (!frame.overlap(box_a, box_b))
+				continue;
+			const bool a_leaf = A.is_leaf(a);
+			const bool b_leaf = B.is_leaf(b);
+			if (a_leaf && b_leaf)
+			{
+				for (int i = 0; i < A.size(a); i++)
+				{
+					for (int j = 0; j < B.size(b); j++)
+					{
+						leaves[num_leaves++] = std::make_pair(A.primitive(a, i), B.primitive(b, j));
+						if (num_leaves == max_leaves)
+						{
+							if (test_leaves(VA, FA, VB, FB, frame, leaves, num_leaves, first_hit_only, contacts))
+								return true;
+							num_leaves = 0;
+						}
+					}
+				}
+				continue;
+			}
+			assert(top + 2 <= max_stack && "trees deeper than 64 levels");
+			if (b_leaf || (!a_leaf && frame.radius_a(box_a) >= frame.radius_b(box_b)))
+			{
+				stack[top++] = Pair(A.right(a), b);
+				stack[top++] = Pair(A.left(a), b);
+			}
+			else
+			{
+				stack[top++] = Pair(a, B.right(b));
+				stack[top++] = Pair(a, B.left(b));
+			}
+		}
+		test_leaves(VA, FA, VB, FB, frame, leaves, num_leaves, first_hit_only, contacts);
+		return !contacts.empty();
+	}
+}
+
+
+IGL_INLINE bool igl::aabb_trees_intersect(
+	const Eigen::MatrixXd& VA,
+	const Eigen::MatrixXi& FA,
+	const AABB<Eigen::MatrixXd, 3>& A,
+	const Eigen::MatrixXd& VB,
+	const Eigen::MatrixXi& FB,
+	const AABB<Eigen::MatrixXd, 3>& B,
+	const RelativeFrame& frame,
+	const bool first_hit_only,
+	std::vector<std::pair<int, int> >& contacts)
+{
+	return intersect(VA, FA, AABBNodes(A), VB, FB, AABBNodes(B), frame, first_hit_only, contacts);
+}
+
+IGL_INLINE bool igl::aabb_trees_intersect(
+	const Eigen::MatrixXd& VA,
+	const Eigen::MatrixXi& FA,
+	const FlatBVH& A,
+	const Eigen::MatrixXd& VB,
+	const Eigen::MatrixXi& FB,
+	const FlatBVH& B,
+	const RelativeFrame& frame,
+	const bool first_hit_only,
+	std::vector<std::pair<int, int> >& contacts)
+{
+	return intersect(VA, FA, A, VB, FB, B, frame, first_hit_only, contacts);
+}
@@ -0,0 +1,59 @@
+#ifndef IGL_AABB_TREES_INTERSECT_H
+#define IGL_AABB_TREES_INTERSECT_H
+#include "igl_inline.h"
+#include "AABB.h"
+#include <Eigen/Core>
+#include <utility>
+#include <vector>
+namespace igl
+{
+    class FlatBVH;
+    class RelativeFrame;
+    // Pairs of intersecting triangles of two meshes, with their AABB trees
+    // placed in the world as described by frame (see RelativeFrame), e.g.
+    // two meshes of the viewer.
+    //
+    // Both trees are walked together without recursion: pairs of nodes go
+    // on a fixed size stack, and each overlapping pair of boxes is split on
+    // the larger of the two, so the stack never holds more pairs than the
+    // depths of the two trees added (AABB::init splits at the median, the
+    // depth of a tree is about log2(#F); see FlatBVH for its bound).
+    // Triangle pairs of overlapping leaves are collected in small batches
+    // and tested exactly with tri_tri_intersect in A's frame.
+    //
+    // Inputs:
+    //   VA, FA, A  mesh of A and its tree, in A's local coordinates
+    //   VB, FB, B  mesh of B and its tree, in B's local coordinates
+    //   frame  pose of B relative to A
+    //   first_hit_only  whether to stop at the first intersecting pair
+    // Outputs:
+    //   contacts  list of pairs (face of A, face of B) of intersecting
+    //     triangles, at most one if first_hit_only
+    // Returns true iff some triangles intersect
+    IGL_INLINE bool aabb_trees_intersect(
+        const Eigen::MatrixXd& VA,
+        const Eigen::MatrixXi& FA,
+        const AABB<Eigen::MatrixXd, 3>& A,
+        const Eigen::MatrixXd& VB,
+        const Eigen::MatrixXi& FB,
+        const AABB<Eigen::MatrixXd, 3>& B,
+        const RelativeFrame& frame,
+        const bool first_hit_only,
+        std::vector<std::pair<int, int> >& contacts);
+    // Same with FlatBVH trees
+    IGL_INLINE bool aabb_trees_intersect(
+        const Eigen::MatrixXd& VA,
+        const Eigen::MatrixXi& FA,
+        const FlatBVH& A,
+        const Eigen::MatrixXd& VB,
+        const Eigen::MatrixXi& FB,
+        const FlatBVH& B,
+        const RelativeFrame& frame,
+        const bool first_hit_only,
+        std::vector<std::pair<int, int> >& contacts);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "aabb_trees_intersect.cpp"
+#endif
+#endif
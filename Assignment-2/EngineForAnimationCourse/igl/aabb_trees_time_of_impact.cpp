@@ -0,0 +1,261 @@
+#include "aabb_trees_time_of_impact.h"
+#include "AABBNodes.h"
+#include "FlatBVH.h"
+#include "RelativeFrame.h"
+#include "TraversalFront.h"
+#include "tri_tri_time_of_impact.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace
+{
+	// Earliest contact of the triangles of leaves a and b, if before first
+	template <typename Nodes>
+	void leaves_time_of_impact(
+		const Eigen::MatrixXd& VA,
+		const Eigen::MatrixXi& FA,
+		const Nodes& A,
+		const typename Nodes::NodeRef a,
+		const Eigen::MatrixXd& VB,
+		const Eigen::MatrixXi& FB,
+		const Nodes& B,
+		const typename Nodes::NodeRef b,
+		const igl::RelativeFrame& frame,
+		const Eigen::Vector3d& displacement,
+		double& first,
+		bool& hit,
+		int& fa,
+		int& fb,
+		igl::TreeWalkStats& tests)
+	{
+		tests.triangle_tests += A.size(a) * B.size(b);
+		for (int k = 0; k < A.size(a); k++)
+		{
+			for (int l = 0; l < B.size(b); l++)
+			{
+				const int i = A.primitive(a, k);
+				const int j = B.primitive(b, l);
+				double leaf_t;
+				if (igl::tri_tri_time_of_impact(
+					frame.point_a(VA.row(FA(i, 0)).transpose()),
+					frame.point_a(VA.row(FA(i, 1)).transpose()),
+					frame.point_a(VA.row(FA(i, 2)).transpose()),
+					frame.point_b(VB.row(FB(j, 0)).transpose()),
+					frame.point_b(VB.row(FB(j, 1)).transpose()),
+					frame.point_b(VB.row(FB(j, 2)).transpose()),
+					displacement, first, leaf_t) && (!hit || leaf_t < first))
+				{
+					hit = true;
+					first = leaf_t;
+					fa = i;
+					fb = j;
+				}
+			}
+		}
+	}
+
+	template <typename Nodes>
+	bool time_of_impact(
+		const Eigen::MatrixXd& VA,
+		const Eigen::MatrixXi& FA,
+		const Nodes& A,
+		const Eigen::MatrixXd& VB,
+		const Eigen::MatrixXi& FB,
+		const Nodes& B,
+		const igl::RelativeFrame& frame,
+		const Eigen::Vector3d& displacement,
+		double& t,
+		int& fa,
+		int& fb,
+		igl::TreeWalkStats* stats)
+	{
+		typedef typename Nodes::NodeRef NodeRef;
+		typedef std::pair<NodeRef, NodeRef> Pair;
+		// See aabb_trees_intersect
+		const int max_stack = 128;
+		Pair stack[max_stack];
+		int top = 0;
+		// Earliest contact so far; anything later is pruned
+		double first = 1;
+		bool hit = false;
+		igl::TreeWalkStats tests;
+		stack[top++] = Pair(A.root(), B.root());
+		while (top > 0)
+		{
+			const NodeRef a = stack[--top].first;
+			const NodeRef b = stack[top].second;
+			const Eigen::AlignedBox<double, 3>& box_a = A.box(a);
+			const Eigen::AlignedBox<double, 3>& box_b = B.box(b);
+			double t0 = 0;
+			double t1 = first;
+			tests.box_tests++;
+			if (!frame.overlap(box_a, box_b, displacement, t0, t1))
+				continue;
+			const bool a_leaf = A.is_leaf(a);
+			const bool b_leaf = B.is_leaf(b);
+			if (a_leaf && b_leaf)
+			{
+				leaves_time_of_impact(VA, FA, A, a, VB, FB, B, b, frame, displacement, first, hit, fa, fb, tests);
+				// Nothing can touch before t = 0
+				if (hit && first == 0)
+					break;
+				continue;
+			}
+			assert(top + 2 <= max_stack && "trees deeper than 64 levels");
+			if (b_leaf || (!a_leaf && frame.radius_a(box_a) >= frame.radius_b(box_b)))
+			{
+				stack[top++] = Pair(A.right(a), b);
+				stack[top++] = Pair(A.left(a), b);
+			}
+			else
+			{
+				stack[top++] = Pair(a, B.right(b));
+				stack[top++] = Pair(a, B.left(b));
+			}
+		}
+		if (stats)
+			*stats += tests;
+		if (hit)
+			t = first;
+		return hit;
+	}
+}
+
+IGL_INLINE bool igl::aabb_trees_time_of_impact(
+	const Eigen::MatrixXd& VA,
+	const Eigen::MatrixXi& FA,
+	const AABB<Eigen::MatrixXd, 3>& A,
+	const Eigen::MatrixXd& VB,
+	const Eigen::MatrixXi& FB,
+	const AABB<Eigen::MatrixXd, 3>& B,
+	const RelativeFrame& frame,
+	const Eigen::Vector3d& displacement,
+	double& t,
+	int& fa,
+	int& fb,
+	TreeWalkStats* stats)
+{
+	return time_of_impact(VA, FA, AABBNodes(A), VB, FB, AABBNodes(B), frame, displacement, t, fa, fb, stats);
+}
+
+IGL_INLINE bool igl::aabb_trees_time_of_impact(
+	const Eigen::MatrixXd& VA,
+	const Eigen::MatrixXi& FA,
+	const FlatBVH& A,
+	const Eigen::MatrixXd& VB,
+	const Eigen::MatrixXi& FB,
+	const FlatBVH& B,
+	const RelativeFrame& frame,
+	const Eigen::Vector3d& displacement,
+	double& t,
+	int& fa,
+	int& fb,
+	TreeWalkStats* stats)
+{
+	return time_of_impact(VA, FA, A, VB, FB, B, frame, displacement, t, fa, fb, stats);
+}
+
+IGL_INLINE bool igl::aabb_trees_time_of_impact(
+	const Eigen::MatrixXd& VA,
+	const Eigen::MatrixXi& FA,
+	const FlatBVH& A,
+	const Eigen::MatrixXd& VB,
+	const Eigen::MatrixXi& FB,
+	const FlatBVH& B,
+	const RelativeFrame& frame,
+	const Eigen::Vector3d& displacement,
+	TraversalFront& front,
+	double& t,
+	int& fa,
+	int& fb,
+	TreeWalkStats* stats)
+{
+	typedef TraversalFront::Node Pair;
+	front.prepare(A, B);
+	std::vector<Pair>& pairs = front.m_nodes;
+	double first = 1;
+	bool hit = false;
+	TreeWalkStats tests;
+	// Pairs of the front, then the ones they are split into, which are
+	// appended
+	for (int p = 0; p < int(pairs.size()); p++)
+	{
+		if (pairs[p].child != -1)
+			continue;
+		const int a = pairs[p].a;
+		const int b = pairs[p].b;
+		const Eigen::AlignedBox<double, 3> box_a = A.box(a);
+		const Eigen::AlignedBox<double, 3> box_b = B.box(b);
+		double t0 = 0;
+		double t1 = first;
+		tests.box_tests++;
+		if (!frame.overlap(box_a, box_b, displacement, t0, t1, pairs[p].axis))
+		{
+			pairs[p].apart++;
+			continue;
+		}
+		pairs[p].apart = 0;
+		const bool a_leaf = A.is_leaf(a);
+		const bool b_leaf = B.is_leaf(b);
+		if (a_leaf && b_leaf)
+		{
+			leaves_time_of_impact(VA, FA, A, a, VB, FB, B, b, frame, displacement, first, hit, fa, fb, tests);
+			if (hit && first == 0)
+				break;
+			continue;
+		}
+		// Split as the walk from the roots does
+		Pair child = pairs[p];
+		child.parent = p;
+		child.child = -1;
+		child.axis = -1;
+		pairs[p].child = pairs.size();
+		if (b_leaf || (!a_leaf && frame.radius_a(box_a) >= frame.radius_b(box_b)))
+		{
+			child.a = A.left(a);
+			pairs.push_back(child);
+			child.a = A.right(a);
+			pairs.push_back(child);
+		}
+		else
+		{
+			child.b = B.left(b);
+			pairs.push_back(child);
+			child.b = B.right(b);
+			pairs.push_back(child);
+		}
+	}
+
+	// Merge back pairs whose two halves have been apart for a while and
+	// whose boxes are apart over the whole step, children first so that
+	// merges can go up several levels. Attempts that fail are retried less
+	// and less often.
+	for (int p = int(pairs.size()) - 1; p >= 0; p--)
+	{
+		const int c = pairs[p].child;
+		if (c < 0 || pairs[c].child != -1 || pairs[c + 1].child != -1)
+			continue;
+		const int apart = std::min(pairs[c].apart, pairs[c + 1].apart);
+		if (apart < 2 || ((apart & (apart - 1)) != 0 && apart % 64 != 0))
+			continue;
+		double t0 = 0;
+		double t1 = 1;
+		tests.box_tests++;
+		if (frame.overlap(A.box(pairs[p].a), B.box(pairs[p].b), displacement, t0, t1, pairs[p].axis))
+			continue;
+		pairs[p].child = -1;
+		pairs[p].apart = apart;
+		pairs[c].child = -2;
+		pairs[c + 1].child = -2;
+		front.m_merged += 2;
+	}
+	if (2 * front.m_merged > int(pairs.size()))
+		front.compact();
+
+	if (stats)
+		*stats += tests;
+	if (hit)
+		t = first;
+	return hit;
+}
@@ -0,0 +1,88 @@
+#ifndef IGL_AABB_TREES_TIME_OF_IMPACT_H
+#define IGL_AABB_TREES_TIME_OF_IMPACT_H
+#include "igl_inline.h"
+#include "AABB.h"
+#include "TreeWalkStats.h"
+#include <Eigen/Core>
+namespace igl
+{
+    class FlatBVH;
+    class RelativeFrame;
+    class TraversalFront;
+    // Continuous collision detection between two meshes: first time t in
+    // [0, 1] at which they touch while B translates by t * displacement
+    // relative to A, e.g. during one step of the viewer's motion, so that
+    // fast objects or thin meshes cannot pass through each other between
+    // two poses.
+    //
+    // The trees are walked as in aabb_trees_intersect, but each pair of
+    // boxes is tested over the whole motion (RelativeFrame::overlap with a
+    // time window) and the window is cut to the earliest contact found so
+    // far, so pairs that can only touch later are pruned. Leaves get the
+    // exact tri_tri_time_of_impact.
+    //
+    // Inputs:
+    //   VA, FA, A  mesh of A and its tree, in A's local coordinates
+    //   VB, FB, B  mesh of B and its tree, in B's local coordinates
+    //   frame  pose of B relative to A at t = 0
+    //   displacement  motion of B relative to A in A's frame (see
+    //     RelativeFrame::vector_a)
+    // Outputs:
+    //   t  time of impact
+    //   fa, fb  faces of A and B that touch first
+    //   stats  if not null, the tests done are added to it
+    // Returns true iff the meshes touch for some t in [0, 1]
+    IGL_INLINE bool aabb_trees_time_of_impact(
+        const Eigen::MatrixXd& VA,
+        const Eigen::MatrixXi& FA,
+        const AABB<Eigen::MatrixXd, 3>& A,
+        const Eigen::MatrixXd& VB,
+        const Eigen::MatrixXi& FB,
+        const AABB<Eigen::MatrixXd, 3>& B,
+        const RelativeFrame& frame,
+        const Eigen::Vector3d& displacement,
+        double& t,
+        int& fa,
+        int& fb,
+        TreeWalkStats* stats = nullptr);
+    // Same with FlatBVH trees
+    IGL_INLINE bool aabb_trees_time_of_impact(
+        const Eigen::MatrixXd& VA,
+        const Eigen::MatrixXi& FA,
+        const FlatBVH& A,
+        const Eigen::MatrixXd& VB,
+        const Eigen::MatrixXi& FB,
+        const FlatBVH& B,
+        const RelativeFrame& frame,
+        const Eigen::Vector3d& displacement,
+        double& t,
+        int& fa,
+        int& fb,
+        TreeWalkStats* stats = nullptr);
+    // Same, starting from where the last query of the same two trees
+    // stopped, and leaving there where this one stops (see TraversalFront)
+    //
+    // Inputs:
+    //   front  front of the last query, or a new one
+    // Outputs:
+    //   front  front of this query
+    IGL_INLINE bool aabb_trees_time_of_impact(
+        const Eigen::MatrixXd& VA,
+        const Eigen::MatrixXi& FA,
+        const FlatBVH& A,
+        const Eigen::MatrixXd& VB,
+        const Eigen::MatrixXi& FB,
+        const FlatBVH& B,
+        const RelativeFrame& frame,
+        const Eigen::Vector3d& displacement,
+        TraversalFront& front,
+        double& t,
+        int& fa,
+        int& fb,
+        TreeWalkStats* stats = nullptr);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "aabb_trees_time_of_impact.cpp"
+#endif
+#endif
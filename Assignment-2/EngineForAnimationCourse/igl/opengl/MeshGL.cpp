@@ -40,6 +40,14 @@ IGL_INLINE void igl::opengl::MeshGL::init_buffers()
 	glGenBuffers(1, &vbo_points_V);
 	glGenBuffers(1, &vbo_points_V_colors);
 
+	// Box overlay
+	glGenVertexArrays(1, &vao_overlay_boxes);
+	glBindVertexArray(vao_overlay_boxes);
+	glGenBuffers(1, &vbo_box_lines);
+	glGenBuffers(1, &vbo_boxes);
+	boxes_capacity = 0;
+	boxes_count = 0;
+
 	dirty = MeshGL::DIRTY_ALL;
 }
 
@@ -50,6 +58,7 @@ IGL_INLINE void igl::opengl::MeshGL::free_buffers()
 		glDeleteVertexArrays(1, &vao_mesh);
 		glDeleteVertexArrays(1, &vao_overlay_lines);
 		glDeleteVertexArrays(1, &vao_overlay_points);
+		glDeleteVertexArrays(1, &vao_overlay_boxes);
 
 		glDeleteBuffers(1, &vbo_V);
 		glDeleteBuffers(1, &vbo_V_normals);
@@ -64,6 +73,8 @@ IGL_INLINE void igl::opengl::MeshGL::free_buffers()
 		glDeleteBuffers(1, &vbo_points_F);
 		glDeleteBuffers(1, &vbo_points_V);
 		glDeleteBuffers(1, &vbo_points_V_colors);
+		glDeleteBuffers(1, &vbo_box_lines);
+		glDeleteBuffers(1, &vbo_boxes);
 
 		glDeleteTextures(1, &vbo_tex);
 	}
@@ -131,6 +142,29 @@ IGL_INLINE void igl::opengl::MeshGL::bind_overlay_points()
 	dirty &= ~MeshGL::DIRTY_OVERLAY_POINTS;
 }
 
+IGL_INLINE void igl::opengl::MeshGL::bind_overlay_boxes(const RowMatrixXf& boxes, int count)
+{
+	glBindVertexArray(vao_overlay_boxes);
+	glUseProgram(shader_overlay_boxes);
+
+	if (dirty & MeshGL::DIRTY_OVERLAY_BOXES)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, vbo_boxes);
+		// Grow with the storage of the boxes, so that a frame with as many
+		// boxes as before only copies them
+		if (boxes.rows() > boxes_capacity)
+		{
+			boxes_capacity = boxes.rows();
+			glBufferData(GL_ARRAY_BUFFER, sizeof(float) * boxes.size(), nullptr, GL_DYNAMIC_DRAW);
+		}
+		if (count > 0)
+			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * 9 * count, boxes.data());
+		boxes_count = count;
+	}
+
+	dirty &= ~MeshGL::DIRTY_OVERLAY_BOXES;
+}
+
 IGL_INLINE void igl::opengl::MeshGL::draw_mesh(bool solid)
 {
 	glPolygonMode(GL_FRONT_AND_BACK, solid ? GL_FILL : GL_LINE);
@@ -157,6 +191,11 @@ IGL_INLINE void igl::opengl::MeshGL::draw_overlay_points()
 	glDrawElements(GL_POINTS, points_F_vbo.rows(), GL_UNSIGNED_INT, 0);
 }
 
+IGL_INLINE void igl::opengl::MeshGL::draw_overlay_boxes()
+{
+	glDrawArraysInstanced(GL_LINES, 0, 24, boxes_count);
+}
+
 IGL_INLINE void igl::opengl::MeshGL::init()
 {
 	if (is_initialized)
@@ -252,6 +291,24 @@ IGL_INLINE void igl::opengl::MeshGL::init()
   }
 )";
 
+	// Each instance is the unit cube scaled and moved onto one box
+	std::string overlay_box_vertex_shader_string =
+		R"(#version 150
+  uniform mat4 view;
+  uniform mat4 proj;
+  in vec3 corner;
+  in vec3 box_min;
+  in vec3 box_size;
+  in vec3 color;
+  out vec3 color_frag;
+
+  void main()
+  {
+    gl_Position = proj * view * vec4 (box_min + corner * box_size, 1.0);
+    color_frag = color;
+  }
+)";
+
 	std::string overlay_fragment_shader_string =
 		R"(#version 150
   in vec3 color_frag;
@@ -291,6 +348,34 @@ IGL_INLINE void igl::opengl::MeshGL::init()
 		overlay_point_fragment_shader_string,
 		{},
 		shader_overlay_points);
+
+	create_shader_program(
+		overlay_box_vertex_shader_string,
+		overlay_fragment_shader_string,
+		{},
+		shader_overlay_boxes);
+
+	// The 12 edges of the unit cube, and the per instance attributes of the
+	// boxes, which stay bound to vbo_boxes when it is reallocated
+	const float cube_edges[24][3] = {
+		{ 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 1, 0 }, { 0, 0, 0 },
+		{ 0, 0, 1 }, { 1, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 1, 1, 1 }, { 0, 1, 1 }, { 0, 1, 1 }, { 0, 0, 1 },
+		{ 0, 0, 0 }, { 0, 0, 1 }, { 1, 0, 0 }, { 1, 0, 1 }, { 1, 1, 0 }, { 1, 1, 1 }, { 0, 1, 0 }, { 0, 1, 1 } };
+	glBindVertexArray(vao_overlay_boxes);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo_box_lines);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(cube_edges), cube_edges, GL_STATIC_DRAW);
+	GLint id = glGetAttribLocation(shader_overlay_boxes, "corner");
+	glVertexAttribPointer(id, 3, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(id);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo_boxes);
+	const char* instance_attributes[] = { "box_min", "box_size", "color" };
+	for (int i = 0; i < 3; i++)
+	{
+		id = glGetAttribLocation(shader_overlay_boxes, instance_attributes[i]);
+		glVertexAttribPointer(id, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (GLvoid*)(3 * i * sizeof(float)));
+		glEnableVertexAttribArray(id);
+		glVertexAttribDivisor(id, 1);
+	}
 }
 
 IGL_INLINE void igl::opengl::MeshGL::free()
@@ -309,6 +394,7 @@ IGL_INLINE void igl::opengl::MeshGL::free()
 		free(shader_mesh);
 		free(shader_overlay_lines);
 		free(shader_overlay_points);
+		free(shader_overlay_boxes);
 		free_buffers();
 	}
 }
@@ -39,16 +39,19 @@ public:
     DIRTY_MESH           = 0x00FF,
     DIRTY_OVERLAY_LINES  = 0x0100,
     DIRTY_OVERLAY_POINTS = 0x0200,
-    DIRTY_ALL            = 0x03FF
+    DIRTY_OVERLAY_BOXES  = 0x0400,
+    DIRTY_ALL            = 0x07FF
   };
 
   bool is_initialized = false;
   GLuint vao_mesh;
   GLuint vao_overlay_lines;
   GLuint vao_overlay_points;
+  GLuint vao_overlay_boxes;
   GLuint shader_mesh;
   GLuint shader_overlay_lines;
   GLuint shader_overlay_points;
+  GLuint shader_overlay_boxes;
 
   GLuint vbo_V; // Vertices of the current mesh (#V x 3)
   GLuint vbo_V_uv; // UV coordinates for the current mesh (#V x 2)
@@ -66,6 +69,12 @@ public:
   GLuint vbo_points_F;        // Indices of the point overlay
   GLuint vbo_points_V;        // Vertices of the point overlay
   GLuint vbo_points_V_colors; // Color values of the point overlay
+  GLuint vbo_box_lines;       // Edges of the unit cube, shared by all boxes
+  GLuint vbo_boxes;           // Corner, size and color of each box (one instance each)
+
+  // Rows allocated in vbo_boxes, and rows of it in use
+  int boxes_capacity = 0;
+  int boxes_count = 0;
 
   // Temporary copy of the content of each VBO
   typedef Eigen::Matrix<float,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMatrixXf;
@@ -118,6 +127,14 @@ public:
   /// Draw the currently buffered point overlay
   IGL_INLINE void draw_overlay_points();
 
+  // Bind the underlying OpenGL buffer objects for subsequent box overlay
+  // draw calls, uploading the first count rows of boxes if they changed
+  // (see ViewerData::boxes)
+  IGL_INLINE void bind_overlay_boxes(const RowMatrixXf& boxes, int count);
+
+  /// Draw the currently buffered boxes in one instanced call
+  IGL_INLINE void draw_overlay_boxes();
+
   // Release the OpenGL buffer objects
   IGL_INLINE void free_buffers();
 
@@ -239,6 +239,20 @@ IGL_INLINE void igl::opengl::ViewerCore::draw(
 			data.meshgl.draw_overlay_points();
 		}
 
+		if (data.boxes_count > 0)
+		{
+			data.meshgl.bind_overlay_boxes(data.boxes, data.boxes_count);
+			viewi = glGetUniformLocation(data.meshgl.shader_overlay_boxes, "view");
+			proji = glGetUniformLocation(data.meshgl.shader_overlay_boxes, "proj");
+
+			glUniformMatrix4fv(viewi, 1, GL_FALSE, view.data());
+			glUniformMatrix4fv(proji, 1, GL_FALSE, proj.data());
+			glEnable(GL_LINE_SMOOTH);
+			glLineWidth(data.line_width);
+
+			data.meshgl.draw_overlay_boxes();
+		}
+
 		glEnable(GL_DEPTH_TEST);
 	}
 
@@ -14,6 +14,7 @@
 #include "../parula.h"
 #include "../per_vertex_normals.h"
 #include "igl/png/texture_from_png.h"
+#include <algorithm>
 #include <iostream>
 //#include "external/stb/igl_stb_image.h"
 
@@ -338,6 +339,23 @@ IGL_INLINE void igl::opengl::ViewerData::add_edges(const Eigen::MatrixXd& P1, co
 	dirty |= MeshGL::DIRTY_OVERLAY_LINES;
 }
 
+IGL_INLINE void igl::opengl::ViewerData::add_box(const Eigen::AlignedBox<double, 3>& box, const Eigen::RowVector3d& color)
+{
+	if (boxes_count == boxes.rows())
+		boxes.conservativeResize(std::max<Eigen::Index>(64, 2 * boxes.rows()), 9);
+	boxes.row(boxes_count) << box.min().transpose().cast<float>(), box.sizes().transpose().cast<float>(), color.cast<float>();
+	boxes_count++;
+
+	dirty |= MeshGL::DIRTY_OVERLAY_BOXES;
+}
+
+IGL_INLINE void igl::opengl::ViewerData::clear_boxes()
+{
+	boxes_count = 0;
+
+	dirty |= MeshGL::DIRTY_OVERLAY_BOXES;
+}
+
 IGL_INLINE void igl::opengl::ViewerData::add_label(const Eigen::VectorXd& P, const std::string& str)
 {
 	Eigen::RowVectorXd P_temp;
@@ -384,6 +402,7 @@ IGL_INLINE void igl::opengl::ViewerData::clear()
 
 	lines = Eigen::MatrixXd(0, 9);
 	points = Eigen::MatrixXd(0, 6);
+	boxes_count = 0;
 	labels_positions = Eigen::MatrixXd(0, 3);
 	labels_strings.clear();
 
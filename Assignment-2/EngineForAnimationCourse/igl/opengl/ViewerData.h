@@ -14,6 +14,7 @@
 #include <cstdint>
 #include "Movable.h"
 //#include <Eigen/Core>
+#include <Eigen/Geometry>
 #include <memory>
 #include <vector>
 
@@ -121,6 +122,18 @@ public:
   // set_edges?
   IGL_INLINE void add_edges (const Eigen::MatrixXd& P1, const Eigen::MatrixXd& P2, const Eigen::MatrixXd& C);
 
+  // Adds the edges of an axis aligned box, drawn in one instanced call with
+  // all other boxes. Unlike lines, boxes are meant to be cleared and added
+  // again every frame: clear_boxes() keeps the storage, which doubles when
+  // full, so this does not allocate once it is large enough.
+  //
+  // Inputs:
+  //   box  bounds in the coordinates of the mesh
+  //   color  rgb color of its edges
+  IGL_INLINE void add_box(const Eigen::AlignedBox<double, 3>& box, const Eigen::RowVector3d& color);
+  // Removes all boxes
+  IGL_INLINE void clear_boxes();
+
   // Adds text labels at the given positions in 3D.
   // Note: This requires the ImGui viewer plugin to display text labels.
   IGL_INLINE void add_label (const Eigen::VectorXd& P,  const std::string& str);
@@ -188,6 +201,12 @@ public:
   // with P the position in global coordinates of the center of the point, and C the color in floating point rgb format
   Eigen::MatrixXd points;
 
+  // Boxes plotted over the scene
+  // (Every row up to boxes_count contains 9 floats in the following format M_x, M_y, M_z, S_x, S_y, S_z, C_r, C_g, C_b),
+  // with M the minimum corner and S the size of the box, and C the color in floating point rgb format
+  MeshGL::RowMatrixXf boxes;
+  int boxes_count;
+
   // Text labels plotted over the scene
   // Textp contains, in the i-th row, the position in global coordinates where the i-th label should be anchored
   // Texts contains in the i-th position the text of the i-th label
@@ -123,12 +123,9 @@ bool Display::launch_rendering(bool loop)
 		renderer->core().toggle(renderer->GetScene()->data_list[i].show_lines);
 	while (!glfwWindowShouldClose(window))
 	{
-		for (int i = 0; i < scn->data_list.size(); i++)
-		{
-			scn->check_and_handle_intersect(i);
-		}
 		double tic = igl::get_seconds();
 		renderer->Animate();
+		scn->check_and_handle_intersections();
 		renderer->draw(window);
 		glfwSwapBuffers(window);
 		if (renderer->core().is_animating || frame_counter++ < num_extra_frames)
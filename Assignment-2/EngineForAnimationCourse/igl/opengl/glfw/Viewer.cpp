@@ -66,6 +66,7 @@ namespace igl
 			IGL_INLINE Viewer::Viewer() :
 				data_list(1),
 				data_vel(10),
+				speed(0.005),
 				selected_data_index(0),
 				next_data_id(1),
 				isPicked(false),
@@ -365,6 +366,30 @@ namespace igl
 				return prevTrans;
 			}
 
+			Eigen::Vector3d Viewer::GetDisplacement(int indx)
+			{
+				Eigen::Vector3d direction;
+				switch (data_vel[indx])
+				{
+				case left:
+					direction = Eigen::Vector3d(-1, 0, 0);
+					break;
+				case right:
+					direction = Eigen::Vector3d(1, 0, 0);
+					break;
+				case up:
+					direction = Eigen::Vector3d(0, 1, 0);
+					break;
+				case down:
+					direction = Eigen::Vector3d(0, -1, 0);
+					break;
+				default:
+					return Eigen::Vector3d::Zero();
+				}
+				// Directions are on screen, i.e. in the rotated scene
+				return GetRotation().transpose() * direction * speed;
+			}
+
 		} // end namespace
 	} // end namespace
 }
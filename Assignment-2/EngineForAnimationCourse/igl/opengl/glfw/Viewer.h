@@ -123,6 +123,9 @@ namespace glfw
     IGL_INLINE size_t mesh_index(const int id) const;
 
 	Eigen::Matrix4d CalcParentsTrans(int indx);
+	// Translation of data_list[indx] during one frame, according to
+	// data_vel and speed, in the system of its parent
+	Eigen::Vector3d GetDisplacement(int indx);
 	inline bool SetAnimation() { return isActive = !isActive; }
 public:
     //////////////////////
@@ -134,6 +137,8 @@ public:
     // Stores all the data that should be visualized
     std::vector<ViewerData> data_list;
     std::vector<velocity> data_vel;
+	// Distance moved per frame by meshes with a velocity
+	double speed;
 
 
 	std::vector<int> parents;
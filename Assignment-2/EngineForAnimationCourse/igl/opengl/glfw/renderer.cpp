@@ -70,23 +70,7 @@ IGL_INLINE void Renderer::draw(GLFWwindow* window)
 		int indx = 0;
 		for (auto& mesh : scn->data_list)
 		{
-			switch (scn->data_vel[indx])
-			{
-			case igl::opengl::glfw::velocity::left:
-				mesh.TranslateInSystem(scn->GetRotation(), Eigen::Vector3d(-0.005, 0, 0));
-				break;
-			case igl::opengl::glfw::velocity::right:
-				mesh.TranslateInSystem(scn->GetRotation(), Eigen::Vector3d(0.005, 0, 0));
-				break;
-			case igl::opengl::glfw::velocity::up:
-				mesh.TranslateInSystem(scn->GetRotation(), Eigen::Vector3d(0, 0.005, 0));
-				break;
-			case igl::opengl::glfw::velocity::down:
-				mesh.TranslateInSystem(scn->GetRotation(), Eigen::Vector3d(0, -0.005, 0));
-				break;
-			default:
-				break;
-			}
+			mesh.MyTranslate(scn->GetDisplacement(indx), true);
 			if (mesh.is_visible & core.id)
 			{// for kinematic chain change scn->MakeTrans to parent matrix
 
@@ -0,0 +1,215 @@
+#include "tri_tri_intersect.h"
+#include <Eigen/Geometry>
+
+namespace
+{
+	typedef Eigen::Vector3d V3;
+	typedef Eigen::Vector2d V2;
+
+	double orient_2d(const V2& a, const V2& b, const V2& c)
+	{
+		return (a(0) - c(0)) * (b(1) - c(1)) - (a(1) - c(1)) * (b(0) - c(0));
+	}
+
+	// 2D case analysis of the paper when p1 lies in the region outside the
+	// two edges of the second triangle at p2
+	bool intersection_test_vertex(const V2& p1, const V2& q1, const V2& r1, const V2& p2, const V2& q2, const V2& r2)
+	{
+		if (orient_2d(r2, p2, q1) >= 0)
+		{
+			if (orient_2d(r2, q2, q1) <= 0)
+			{
+				if (orient_2d(p1, p2, q1) > 0)
+					return orient_2d(p1, q2, q1) <= 0;
+				return orient_2d(p1, p2, r1) >= 0 && orient_2d(q1, r1, p2) >= 0;
+			}
+			return orient_2d(p1, q2, q1) <= 0 && orient_2d(r2, q2, r1) <= 0 && orient_2d(q1, r1, q2) >= 0;
+		}
+		if (orient_2d(r2, p2, r1) >= 0)
+		{
+			if (orient_2d(q1, r1, r2) >= 0)
+				return orient_2d(p1, p2, r1) >= 0;
+			return orient_2d(q1, r1, q2) >= 0 && orient_2d(r2, r1, q2) >= 0;
+		}
+		return false;
+	}
+
+	// Same when p1 lies in the region outside edge p2-q2 only
+	bool intersection_test_edge(const V2& p1, const V2& q1, const V2& r1, const V2& p2, const V2& /*q2*/, const V2& r2)
+	{
+		if (orient_2d(r2, p2, q1) >= 0)
+		{
+			if (orient_2d(p1, p2, q1) >= 0)
+				return orient_2d(p1, q1, r2) >= 0;
+			return orient_2d(q1, r1, p2) >= 0 && orient_2d(r1, p1, p2) >= 0;
+		}
+		if (orient_2d(r2, p2, r1) >= 0 && orient_2d(p1, p2, r1) >= 0)
+			return orient_2d(p1, r1, r2) >= 0 || orient_2d(q1, r1, r2) >= 0;
+		return false;
+	}
+
+	// Both triangles counter clockwise: locate p1 among the regions cut by
+	// the lines of the edges of the second triangle
+	bool ccw_tri_tri_intersection_2d(const V2& p1, const V2& q1, const V2& r1, const V2& p2, const V2& q2, const V2& r2)
+	{
+		if (orient_2d(p2, q2, p1) >= 0)
+		{
+			if (orient_2d(q2, r2, p1) >= 0)
+			{
+				if (orient_2d(r2, p2, p1) >= 0)
+					return true;
+				return intersection_test_edge(p1, q1, r1, p2, q2, r2);
+			}
+			if (orient_2d(r2, p2, p1) >= 0)
+				return intersection_test_edge(p1, q1, r1, r2, p2, q2);
+			return intersection_test_vertex(p1, q1, r1, p2, q2, r2);
+		}
+		if (orient_2d(q2, r2, p1) >= 0)
+		{
+			if (orient_2d(r2, p2, p1) >= 0)
+				return intersection_test_edge(p1, q1, r1, q2, r2, p2);
+			return intersection_test_vertex(p1, q1, r1, q2, r2, p2);
+		}
+		return intersection_test_vertex(p1, q1, r1, r2, p2, q2);
+	}
+
+	bool tri_tri_overlap_2d(const V2& p1, const V2& q1, const V2& r1, const V2& p2, const V2& q2, const V2& r2)
+	{
+		if (orient_2d(p1, q1, r1) < 0)
+		{
+			if (orient_2d(p2, q2, r2) < 0)
+				return ccw_tri_tri_intersection_2d(p1, r1, q1, p2, r2, q2);
+			return ccw_tri_tri_intersection_2d(p1, r1, q1, p2, q2, r2);
+		}
+		if (orient_2d(p2, q2, r2) < 0)
+			return ccw_tri_tri_intersection_2d(p1, q1, r1, p2, r2, q2);
+		return ccw_tri_tri_intersection_2d(p1, q1, r1, p2, q2, r2);
+	}
+
+	bool coplanar_tri_tri(const V3& p1, const V3& q1, const V3& r1, const V3& p2, const V3& q2, const V3& r2, const V3& n1)
+	{
+		// Drop the coordinate along which the normal is largest
+		const V3 n = n1.cwiseAbs();
+		int x = 0, y = 1;
+		if (n(0) > n(2) && n(0) >= n(1))
+		{
+			x = 1;
+			y = 2;
+		}
+		else if (n(1) > n(2) && n(1) >= n(0))
+		{
+			x = 0;
+			y = 2;
+		}
+		return tri_tri_overlap_2d(
+			V2(p1(x), p1(y)), V2(q1(x), q1(y)), V2(r1(x), r1(y)),
+			V2(p2(x), p2(y)), V2(q2(x), q2(y)), V2(r2(x), r2(y)));
+	}
+
+	// p1 is alone on its side of the plane of the second triangle and p2 on
+	// its side of the plane of the first, with the triangles permuted so
+	// that the orientations match: the intervals where the triangles cross
+	// the line of intersection of the planes overlap iff these two
+	// orientation tests pass
+	bool check_min_max(const V3& p1, const V3& q1, const V3& r1, const V3& p2, const V3& q2, const V3& r2)
+	{
+		if ((p2 - q1).cross(p1 - q1).dot(q2 - q1) > 0)
+			return false;
+		return (p2 - p1).cross(r1 - p1).dot(r2 - p1) <= 0;
+	}
+
+	// Put the second triangle in canonical form, p2 alone on its side of
+	// the plane of the first triangle
+	bool tri_tri_3d(const V3& p1, const V3& q1, const V3& r1, const V3& p2, const V3& q2, const V3& r2,
+		const double dp2, const double dq2, const double dr2, const V3& n1)
+	{
+		if (dp2 > 0)
+		{
+			if (dq2 > 0)
+				return check_min_max(p1, r1, q1, r2, p2, q2);
+			if (dr2 > 0)
+				return check_min_max(p1, r1, q1, q2, r2, p2);
+			return check_min_max(p1, q1, r1, p2, q2, r2);
+		}
+		if (dp2 < 0)
+		{
+			if (dq2 < 0)
+				return check_min_max(p1, q1, r1, r2, p2, q2);
+			if (dr2 < 0)
+				return check_min_max(p1, q1, r1, q2, r2, p2);
+			return check_min_max(p1, r1, q1, p2, q2, r2);
+		}
+		if (dq2 < 0)
+		{
+			if (dr2 >= 0)
+				return check_min_max(p1, r1, q1, q2, r2, p2);
+			return check_min_max(p1, q1, r1, p2, q2, r2);
+		}
+		if (dq2 > 0)
+		{
+			if (dr2 > 0)
+				return check_min_max(p1, r1, q1, p2, q2, r2);
+			return check_min_max(p1, q1, r1, q2, r2, p2);
+		}
+		if (dr2 > 0)
+			return check_min_max(p1, q1, r1, r2, p2, q2);
+		if (dr2 < 0)
+			return check_min_max(p1, r1, q1, r2, p2, q2);
+		return coplanar_tri_tri(p1, q1, r1, p2, q2, r2, n1);
+	}
+}
+
+IGL_INLINE bool igl::tri_tri_intersect(
+	const Eigen::Vector3d& p1, const Eigen::Vector3d& q1, const Eigen::Vector3d& r1,
+	const Eigen::Vector3d& p2, const Eigen::Vector3d& q2, const Eigen::Vector3d& r2)
+{
+	// Signs of the corners of the first triangle w.r.t. the plane of the second
+	const V3 n2 = (p2 - r2).cross(q2 - r2);
+	const double dp1 = (p1 - r2).dot(n2);
+	const double dq1 = (q1 - r2).dot(n2);
+	const double dr1 = (r1 - r2).dot(n2);
+	if (dp1 * dq1 > 0 && dp1 * dr1 > 0)
+		return false;
+	// and the other way round
+	const V3 n1 = (q1 - p1).cross(r1 - p1);
+	const double dp2 = (p2 - r1).dot(n1);
+	const double dq2 = (q2 - r1).dot(n1);
+	const double dr2 = (r2 - r1).dot(n1);
+	if (dp2 * dq2 > 0 && dp2 * dr2 > 0)
+		return false;
+
+	// Put the first triangle in canonical form, p1 alone on its side
+	if (dp1 > 0)
+	{
+		if (dq1 > 0)
+			return tri_tri_3d(r1, p1, q1, p2, r2, q2, dp2, dr2, dq2, n1);
+		if (dr1 > 0)
+			return tri_tri_3d(q1, r1, p1, p2, r2, q2, dp2, dr2, dq2, n1);
+		return tri_tri_3d(p1, q1, r1, p2, q2, r2, dp2, dq2, dr2, n1);
+	}
+	if (dp1 < 0)
+	{
+		if (dq1 < 0)
+			return tri_tri_3d(r1, p1, q1, p2, q2, r2, dp2, dq2, dr2, n1);
+		if (dr1 < 0)
+			return tri_tri_3d(q1, r1, p1, p2, q2, r2, dp2, dq2, dr2, n1);
+		return tri_tri_3d(p1, q1, r1, p2, r2, q2, dp2, dr2, dq2, n1);
+	}
+	if (dq1 < 0)
+	{
+		if (dr1 >= 0)
+			return tri_tri_3d(q1, r1, p1, p2, r2, q2, dp2, dr2, dq2, n1);
+		return tri_tri_3d(p1, q1, r1, p2, q2, r2, dp2, dq2, dr2, n1);
+	}
+	if (dq1 > 0)
+	{
+		if (dr1 > 0)
+			return tri_tri_3d(p1, q1, r1, p2, r2, q2, dp2, dr2, dq2, n1);
+		return tri_tri_3d(q1, r1, p1, p2, q2, r2, dp2, dq2, dr2, n1);
+	}
+	if (dr1 > 0)
+		return tri_tri_3d(r1, p1, q1, p2, q2, r2, dp2, dq2, dr2, n1);
+	if (dr1 < 0)
+		return tri_tri_3d(r1, p1, q1, p2, r2, q2, dp2, dr2, dq2, n1);
+	return coplanar_tri_tri(p1, q1, r1, p2, q2, r2, n1);
+}
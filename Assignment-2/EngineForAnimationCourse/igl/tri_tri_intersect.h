@@ -0,0 +1,27 @@
+#ifndef IGL_TRI_TRI_INTERSECT_H
+#define IGL_TRI_TRI_INTERSECT_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+    // Whether two triangles in 3D intersect (touching counts), after
+    // Guigue and Devillers, "Fast and robust triangle-triangle overlap test
+    // using orientation predicates", 2003. Only signs of 3x3 determinants
+    // are used, no intersection points are computed; the common rejection
+    // case (one triangle strictly on one side of the plane of the other)
+    // costs two cross and six dot products. Coplanar triangles are tested
+    // in 2D after projecting onto the axis plane where they are largest.
+    //
+    // Inputs:
+    //   p1, q1, r1  corners of the first triangle
+    //   p2, q2, r2  corners of the second triangle
+    // Returns true iff the triangles share at least a point
+    IGL_INLINE bool tri_tri_intersect(
+        const Eigen::Vector3d& p1, const Eigen::Vector3d& q1, const Eigen::Vector3d& r1,
+        const Eigen::Vector3d& p2, const Eigen::Vector3d& q2, const Eigen::Vector3d& r2);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "tri_tri_intersect.cpp"
+#endif
+#endif
@@ -0,0 +1,77 @@
+#include "tri_tri_time_of_impact.h"
+#include "tri_tri_intersect.h"
+#include <Eigen/Geometry>
+#include <cmath>
+
+namespace
+{
+	typedef Eigen::Vector3d V3;
+
+	// Solve [a b c] x = rhs by Cramer's rule, false if (nearly) singular
+	bool solve_3x3(const V3& a, const V3& b, const V3& c, const V3& rhs, V3& x)
+	{
+		const V3 bc = b.cross(c);
+		const double det = a.dot(bc);
+		const double scale = a.norm() * b.norm() * c.norm();
+		if (!(std::abs(det) > 1e-12 * scale))
+			return false;
+		x(0) = rhs.dot(bc) / det;
+		x(1) = a.dot(rhs.cross(c)) / det;
+		x(2) = a.dot(b.cross(rhs)) / det;
+		return true;
+	}
+
+	// Corner o moving along o + t * dir against the fixed triangle
+	// (p, q, r): o + t dir = p + u (q - p) + v (r - p)
+	void corner_triangle(const V3& o, const V3& dir, const V3& p, const V3& q, const V3& r, double& t)
+	{
+		V3 x;
+		if (!solve_3x3(q - p, r - p, -dir, o - p, x))
+			return;
+		if (x(0) >= 0 && x(1) >= 0 && x(0) + x(1) <= 1 && x(2) >= 0 && x(2) < t)
+			t = x(2);
+	}
+
+	// Fixed edge (p, q) against edge (r, s) moving by t * dir:
+	// p + u (q - p) = r + w (s - r) + t dir
+	void edge_edge(const V3& p, const V3& q, const V3& r, const V3& s, const V3& dir, double& t)
+	{
+		V3 x;
+		if (!solve_3x3(q - p, r - s, -dir, r - p, x))
+			return;
+		if (x(0) >= 0 && x(0) <= 1 && x(1) >= 0 && x(1) <= 1 && x(2) >= 0 && x(2) < t)
+			t = x(2);
+	}
+}
+
+IGL_INLINE bool igl::tri_tri_time_of_impact(
+	const Eigen::Vector3d& p1, const Eigen::Vector3d& q1, const Eigen::Vector3d& r1,
+	const Eigen::Vector3d& p2, const Eigen::Vector3d& q2, const Eigen::Vector3d& r2,
+	const Eigen::Vector3d& displacement,
+	const double max_t,
+	double& t)
+{
+	if (tri_tri_intersect(p1, q1, r1, p2, q2, r2))
+	{
+		t = 0;
+		return true;
+	}
+	if (displacement.squaredNorm() == 0)
+		return false;
+	const V3* A[3] = { &p1, &q1, &r1 };
+	const V3* B[3] = { &p2, &q2, &r2 };
+	double first = max_t + 1;
+	for (int i = 0; i < 3; i++)
+	{
+		corner_triangle(*B[i], displacement, p1, q1, r1, first);
+		// The first triangle moves by -displacement relative to the second
+		corner_triangle(*A[i], -displacement, p2, q2, r2, first);
+	}
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			edge_edge(*A[i], *A[(i + 1) % 3], *B[j], *B[(j + 1) % 3], displacement, first);
+	if (first > max_t)
+		return false;
+	t = first;
+	return true;
+}
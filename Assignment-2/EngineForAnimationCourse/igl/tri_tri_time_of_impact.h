@@ -0,0 +1,36 @@
+#ifndef IGL_TRI_TRI_TIME_OF_IMPACT_H
+#define IGL_TRI_TRI_TIME_OF_IMPACT_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+    // First time at which two triangles touch while the second one
+    // translates by t * displacement, t in [0, max_t]. Triangles that
+    // intersect at t = 0 touch at once; otherwise first contact is between
+    // a corner of one triangle and the other triangle (6 ray/triangle
+    // tests) or between two edges (9 3 by 3 linear solves).
+    //
+    // Inputs:
+    //   p1, q1, r1  corners of the first triangle
+    //   p2, q2, r2  corners of the second triangle at t = 0
+    //   displacement  motion of the second triangle
+    //   max_t  end of the time window
+    // Outputs:
+    //   t  first time of contact, if any
+    // Returns true iff the triangles touch at some t in [0, max_t]
+    //
+    // Motions within the plane of a triangle that would first touch in
+    // that plane are not detected (the solves are degenerate); in a closed
+    // mesh a neighbouring triangle reports the contact instead.
+    IGL_INLINE bool tri_tri_time_of_impact(
+        const Eigen::Vector3d& p1, const Eigen::Vector3d& q1, const Eigen::Vector3d& r1,
+        const Eigen::Vector3d& p2, const Eigen::Vector3d& q2, const Eigen::Vector3d& r2,
+        const Eigen::Vector3d& displacement,
+        const double max_t,
+        double& t);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "tri_tri_time_of_impact.cpp"
+#endif
+#endif
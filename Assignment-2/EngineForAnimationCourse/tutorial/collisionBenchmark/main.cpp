@@ -0,0 +1,446 @@
+// Measures collision detection on generated scenes and writes the results
+// as JSON, to track optimisation work on the sandbox's collision loop.
+//
+// A scene is made of N instances of the given meshes, scaled to a diagonal
+// of 0.5 to 1, with random rotations, placed without overlaps on a jittered
+// grid and moving with random constant velocities inside the grid's box.
+// Every frame, the collisions of the coming step are detected and objects
+// that would touch something stay in place and move back, so that the scene
+// keeps moving (the sandbox stops them instead). Objects bounce off the
+// sides of the box. Each pipeline replays the same scene from the same seed:
+//   brute_aabb  swept world bounds of all pairs of objects tested against
+//               each other, and aabb_trees_time_of_impact on igl::AABB trees
+//               on one thread (the collision loop before the broad phase
+//               and flat trees)
+//   sap_flat    igl::CollisionDetector without traversal fronts: sweep
+//               and prune, then FlatBVH trees walked from their roots on a
+//               worker pool
+//   sap_flat_fronts
+//               igl::CollisionDetector as the sandbox uses it, walks
+//               resuming from the fronts of the last frame
+// For each pipeline the JSON has the time to build the trees, and over all
+// frames the broad phase pairs, the pairs with something moving, the
+// contacts, the box and triangle tests of the tree walks and the time of
+// each phase, in total and per frame.
+//
+// Usage: collisionBenchmark_bin [options] [mesh ...]
+//   -n count   number of objects (default 200)
+//   -f count   number of frames (default 300)
+//   -t count   threads of sap_flat, 0 for one per hardware thread (default)
+//   -s seed    seed of the scene (default 1)
+//   -v speed   largest distance per axis moved in a frame, relative to
+//              the size of the objects (default 0.03)
+//   -p list    pipelines to run (default all of the above)
+//   -o file    output file (default: standard output)
+// Without meshes, sphere.obj, bunny.off and cow.off of tutorial/data are
+// used.
+#include <igl/read_triangle_mesh.h>
+#include <igl/AABB.h>
+#include <igl/FlatBVH.h>
+#include <igl/CollisionDetector.h>
+#include <igl/RelativeFrame.h>
+#include <igl/aabb_trees_time_of_impact.h>
+#include <igl/get_seconds.h>
+#include <igl/PI.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef TUTORIAL_DATA_PATH
+#define TUTORIAL_DATA_PATH "../tutorial/data"
+#endif
+
+struct Mesh
+{
+	std::string file;
+	Eigen::MatrixXd V;
+	Eigen::MatrixXi F;
+};
+
+struct Scene
+{
+	// Mesh of each object
+	std::vector<int> mesh;
+	// Rotation times scale, position and velocity per frame of each object
+	std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d> > linear;
+	std::vector<Eigen::Vector3d> position;
+	std::vector<Eigen::Vector3d> velocity;
+	// Objects move in [0, size]^3
+	double size;
+};
+
+struct Totals
+{
+	long long broad_phase_pairs = 0;
+	long long candidates = 0;
+	long long contacts = 0;
+	igl::TreeWalkStats narrow_phase;
+	double broad_phase_seconds = 0;
+	double narrow_phase_seconds = 0;
+	double max_frame_seconds = 0;
+};
+
+struct Run
+{
+	std::string pipeline;
+	double build_seconds = 0;
+	Totals totals;
+};
+
+static bool parse_list(const std::string& arg, std::vector<std::string>& items)
+{
+	std::stringstream ss(arg);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		if (item.empty())
+			return false;
+		items.push_back(item);
+	}
+	return !items.empty();
+}
+
+static bool parse_count(const char* arg, const int min, int& count)
+{
+	char* end;
+	const long value = std::strtol(arg, &end, 10);
+	if (*end != '\0' || value < min || value > 1000000)
+		return false;
+	count = (int)value;
+	return true;
+}
+
+static Scene make_scene(const std::vector<Mesh>& meshes, const int n, const unsigned seed, const double speed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> uniform(-1, 1);
+	Scene scene;
+	// Cells of the grid are larger than any object, so that they start apart
+	const double cell = 1.2;
+	const int side = (int)std::ceil(std::cbrt((double)n) - 1e-9);
+	scene.size = side * cell;
+	for (int i = 0; i < n; i++)
+	{
+		const int m = i % meshes.size();
+		const Eigen::MatrixXd& V = meshes[m].V;
+		const double diagonal = (V.colwise().maxCoeff() - V.colwise().minCoeff()).norm();
+		const double scale = (0.75 + 0.25 * uniform(generator)) / diagonal;
+		const Eigen::Vector3d axis = Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator)).normalized();
+		const Eigen::Matrix3d linear = Eigen::AngleAxisd(igl::PI * uniform(generator), axis).toRotationMatrix() * scale;
+		// Center of the cell, shifted by the center of the mesh
+		const Eigen::Vector3d center = 0.5 * (V.colwise().maxCoeff() + V.colwise().minCoeff()).transpose();
+		const Eigen::Vector3d cell_center = cell * (Eigen::Vector3d(i % side, (i / side) % side, i / (side * side)) + Eigen::Vector3d::Constant(0.5));
+		const Eigen::Vector3d jitter = 0.05 * Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator));
+		scene.mesh.push_back(m);
+		scene.linear.push_back(linear);
+		scene.position.push_back(cell_center + jitter - linear * center);
+		scene.velocity.push_back(speed * Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator)));
+	}
+	return scene;
+}
+
+// Moves the objects of the scene for one frame given the first contact of
+// each object (> 1 for none)
+static void step(Scene& scene, const std::vector<Eigen::AlignedBox<double, 3> >& bounds, const std::vector<double>& impacts)
+{
+	for (size_t i = 0; i < scene.position.size(); i++)
+	{
+		if (impacts[i] <= 1)
+		{
+			scene.velocity[i] = -scene.velocity[i];
+			continue;
+		}
+		scene.position[i] += scene.velocity[i];
+		const Eigen::Vector3d center = bounds[i].center() + scene.velocity[i];
+		for (int k = 0; k < 3; k++)
+			if ((center(k) < 0 && scene.velocity[i](k) < 0) || (center(k) > scene.size && scene.velocity[i](k) > 0))
+				scene.velocity[i](k) = -scene.velocity[i](k);
+	}
+}
+
+static Run run(const std::string& pipeline, const std::vector<Mesh>& meshes, const int n, const int frames,
+	const unsigned seed, const double speed, const int threads)
+{
+	Run res;
+	res.pipeline = pipeline;
+	Scene scene = make_scene(meshes, n, seed, speed);
+	const bool brute = pipeline == "brute_aabb";
+
+	double t = igl::get_seconds();
+	std::vector<std::unique_ptr<igl::AABB<Eigen::MatrixXd, 3> > > aabb_trees;
+	std::vector<std::unique_ptr<igl::FlatBVH> > flat_trees;
+	for (const Mesh& mesh : meshes)
+	{
+		if (brute)
+		{
+			aabb_trees.emplace_back(new igl::AABB<Eigen::MatrixXd, 3>());
+			aabb_trees.back()->init(mesh.V, mesh.F);
+		}
+		else
+		{
+			flat_trees.emplace_back(new igl::FlatBVH());
+			flat_trees.back()->init(mesh.V, mesh.F);
+		}
+	}
+	res.build_seconds = igl::get_seconds() - t;
+
+	// Objects share the meshes and trees of their mesh
+	std::vector<const Eigen::MatrixXd*> V(n);
+	std::vector<const Eigen::MatrixXi*> F(n);
+	std::vector<igl::FlatBVH*> trees(n);
+	for (int i = 0; i < n; i++)
+	{
+		V[i] = &meshes[scene.mesh[i]].V;
+		F[i] = &meshes[scene.mesh[i]].F;
+		if (!brute)
+			trees[i] = flat_trees[scene.mesh[i]].get();
+	}
+	igl::CollisionDetector detector(threads);
+	detector.m_use_fronts = pipeline == "sap_flat_fronts";
+	igl::CollisionDetector::Transforms transforms(n);
+	std::vector<Eigen::AlignedBox<double, 3> > bounds(n);
+	std::vector<igl::CollisionDetector::Contact> contacts;
+	std::vector<double> impacts(n);
+	Totals& totals = res.totals;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			transforms[i].setIdentity();
+			transforms[i].topLeftCorner<3, 3>() = scene.linear[i];
+			transforms[i].topRightCorner<3, 1>() = scene.position[i];
+			const Eigen::AlignedBox<double, 3>& box = brute ? aabb_trees[scene.mesh[i]]->m_box : flat_trees[scene.mesh[i]]->m_box;
+			const Eigen::Vector3d center = scene.linear[i] * box.center() + scene.position[i];
+			const Eigen::Vector3d half = scene.linear[i].cwiseAbs() * (0.5 * box.sizes());
+			bounds[i] = Eigen::AlignedBox<double, 3>(center - half, center + half);
+		}
+		const double frame_start = igl::get_seconds();
+		if (brute)
+		{
+			t = igl::get_seconds();
+			std::vector<Eigen::AlignedBox<double, 3> > swept(n);
+			for (int i = 0; i < n; i++)
+			{
+				swept[i] = bounds[i];
+				swept[i].extend(bounds[i].min() + scene.velocity[i]);
+				swept[i].extend(bounds[i].max() + scene.velocity[i]);
+			}
+			std::vector<std::pair<int, int> > candidates;
+			for (int a = 0; a < n; a++)
+				for (int b = a + 1; b < n; b++)
+					if (swept[a].intersects(swept[b]))
+					{
+						totals.broad_phase_pairs++;
+						candidates.emplace_back(a, b);
+					}
+			totals.candidates += candidates.size();
+			totals.broad_phase_seconds += igl::get_seconds() - t;
+
+			t = igl::get_seconds();
+			contacts.clear();
+			for (const auto& pair : candidates)
+			{
+				igl::CollisionDetector::Contact contact;
+				contact.a = pair.first;
+				contact.b = pair.second;
+				const igl::RelativeFrame relative(transforms[contact.a], transforms[contact.b]);
+				if (igl::aabb_trees_time_of_impact(
+					*V[contact.a], *F[contact.a], *aabb_trees[scene.mesh[contact.a]],
+					*V[contact.b], *F[contact.b], *aabb_trees[scene.mesh[contact.b]],
+					relative, relative.vector_a(scene.velocity[contact.b] - scene.velocity[contact.a]),
+					contact.t, contact.fa, contact.fb, &totals.narrow_phase))
+				{
+					contacts.push_back(contact);
+				}
+			}
+			totals.narrow_phase_seconds += igl::get_seconds() - t;
+		}
+		else
+		{
+			detector.detect(V, F, trees, transforms, scene.velocity, contacts);
+			const igl::CollisionDetector::Stats& stats = detector.m_stats;
+			totals.broad_phase_pairs += stats.broad_phase_pairs;
+			totals.candidates += stats.candidates;
+			totals.narrow_phase += stats.narrow_phase;
+			totals.broad_phase_seconds += stats.broad_phase_seconds;
+			totals.narrow_phase_seconds += stats.narrow_phase_seconds;
+		}
+		totals.max_frame_seconds = std::max(totals.max_frame_seconds, igl::get_seconds() - frame_start);
+		totals.contacts += contacts.size();
+
+		std::fill(impacts.begin(), impacts.end(), 2.0);
+		for (const auto& contact : contacts)
+		{
+			impacts[contact.a] = std::min(impacts[contact.a], contact.t);
+			impacts[contact.b] = std::min(impacts[contact.b], contact.t);
+		}
+		step(scene, bounds, impacts);
+	}
+	return res;
+}
+
+static std::string json_string(const std::string& s)
+{
+	std::string out = "\"";
+	for (const char c : s)
+	{
+		if (c == '"' || c == '\\')
+			out += std::string("\\") + c;
+		else if ((unsigned char)c < 0x20)
+		{
+			char code[8];
+			std::snprintf(code, sizeof(code), "\\u%04x", c);
+			out += code;
+		}
+		else
+			out += c;
+	}
+	return out + "\"";
+}
+
+int main(int argc, char* argv[])
+{
+	int n = 200;
+	int frames = 300;
+	int threads = 0;
+	int seed = 1;
+	double speed = 0.03;
+	std::vector<std::string> pipelines;
+	std::vector<std::string> files;
+	std::string output;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		bool ok = true;
+		if (arg == "-n" && has_value)
+			ok = parse_count(argv[++i], 1, n);
+		else if (arg == "-f" && has_value)
+			ok = parse_count(argv[++i], 1, frames);
+		else if (arg == "-t" && has_value)
+			ok = parse_count(argv[++i], 0, threads);
+		else if (arg == "-s" && has_value)
+			ok = parse_count(argv[++i], 0, seed);
+		else if (arg == "-v" && has_value)
+		{
+			char* end;
+			speed = std::strtod(argv[++i], &end);
+			ok = *end == '\0' && speed >= 0 && speed <= 1;
+		}
+		else if (arg == "-p" && has_value)
+		{
+			ok = parse_list(argv[++i], pipelines);
+			for (const auto& pipeline : pipelines)
+			{
+				if (pipeline != "brute_aabb" && pipeline != "sap_flat" && pipeline != "sap_flat_fronts")
+				{
+					std::cerr << "Unknown pipeline " << pipeline << std::endl;
+					return 1;
+				}
+			}
+		}
+		else if (arg == "-o" && has_value)
+			output = argv[++i];
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			std::cerr << "Usage: " << argv[0] << " [-n objects] [-f frames] [-t threads] [-s seed] [-v speed] [-p pipelines] [-o file.json] [mesh ...]" << std::endl;
+			return 1;
+		}
+		else
+			files.push_back(arg);
+		if (!ok)
+		{
+			std::cerr << "Bad value for " << arg << ": " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+	if (pipelines.empty())
+		pipelines = { "brute_aabb", "sap_flat", "sap_flat_fronts" };
+	if (files.empty())
+	{
+		for (const char* name : { "sphere.obj", "bunny.off", "cow.off" })
+			files.push_back(std::string(TUTORIAL_DATA_PATH) + "/" + name);
+	}
+	std::vector<Mesh> meshes;
+	for (const auto& file : files)
+	{
+		Mesh mesh;
+		mesh.file = file;
+		if (!igl::read_triangle_mesh(file, mesh.V, mesh.F) || mesh.F.rows() == 0)
+		{
+			std::cerr << "Can't read mesh " << file << std::endl;
+			return 1;
+		}
+		meshes.push_back(mesh);
+	}
+
+	std::ofstream out_file;
+	if (!output.empty())
+	{
+		out_file.open(output);
+		if (!out_file)
+		{
+			std::cerr << "Can't open " << output << std::endl;
+			return 1;
+		}
+	}
+	std::stringstream json;
+	json.precision(10);
+	json << "{\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+		<< ",\n  \"objects\": " << n
+		<< ",\n  \"frames\": " << frames
+		<< ",\n  \"threads\": " << threads
+		<< ",\n  \"seed\": " << seed
+		<< ",\n  \"speed\": " << speed
+		<< ",\n  \"meshes\": [";
+	for (size_t m = 0; m < meshes.size(); m++)
+	{
+		const std::string& file = meshes[m].file;
+		json << (m ? "," : "") << "\n    { \"file\": " << json_string(file)
+			<< ", \"name\": " << json_string(file.substr(file.find_last_of("/\\") + 1))
+			<< ", \"faces\": " << meshes[m].F.rows() << " }";
+	}
+	json << "\n  ],\n  \"runs\": [";
+	for (size_t r = 0; r < pipelines.size(); r++)
+	{
+		const Run res = run(pipelines[r], meshes, n, frames, seed, speed, threads);
+		const Totals& totals = res.totals;
+		const double seconds = totals.broad_phase_seconds + totals.narrow_phase_seconds;
+		std::cerr << res.pipeline << ": " << totals.contacts << " contacts, broad phase "
+			<< totals.broad_phase_seconds << "s, narrow phase " << totals.narrow_phase_seconds << "s" << std::endl;
+		json << (r ? "," : "") << "\n    {\n      \"pipeline\": " << json_string(res.pipeline)
+			<< ",\n      \"build_seconds\": " << res.build_seconds
+			<< ",\n      \"total\": { \"broad_phase_pairs\": " << totals.broad_phase_pairs
+			<< ", \"candidates\": " << totals.candidates
+			<< ", \"contacts\": " << totals.contacts
+			<< ", \"box_tests\": " << totals.narrow_phase.box_tests
+			<< ", \"triangle_tests\": " << totals.narrow_phase.triangle_tests
+			<< ", \"broad_phase_seconds\": " << totals.broad_phase_seconds
+			<< ", \"narrow_phase_seconds\": " << totals.narrow_phase_seconds
+			<< ", \"seconds\": " << seconds << " }"
+			<< ",\n      \"per_frame\": { \"broad_phase_pairs\": " << (double)totals.broad_phase_pairs / frames
+			<< ", \"candidates\": " << (double)totals.candidates / frames
+			<< ", \"contacts\": " << (double)totals.contacts / frames
+			<< ", \"box_tests\": " << (double)totals.narrow_phase.box_tests / frames
+			<< ", \"triangle_tests\": " << (double)totals.narrow_phase.triangle_tests / frames
+			<< ", \"broad_phase_seconds\": " << totals.broad_phase_seconds / frames
+			<< ", \"narrow_phase_seconds\": " << totals.narrow_phase_seconds / frames
+			<< ", \"seconds\": " << seconds / frames
+			<< ", \"max_seconds\": " << totals.max_frame_seconds << " }"
+			<< "\n    }";
+	}
+	json << "\n  ]\n}\n";
+	(output.empty() ? std::cout : out_file) << json.str();
+	return 0;
+}
@@ -1,19 +1,35 @@
 #pragma once
 #include "igl/opengl/glfw/Viewer.h"
 #include "igl/aabb.h"
+#include "igl/FlatBVH.h"
+#include "igl/CollisionDetector.h"
 
 class SandBox : public igl::opengl::glfw::Viewer
 {
 public:
-	std::vector<igl::AABB<Eigen::MatrixXd, 3>*> trees;
+	std::vector<igl::FlatBVH*> trees;
 	std::vector<igl::AABB<Eigen::MatrixXd, 3>*> sub_trees;
 	SandBox();
 
-	void check_and_handle_intersect(int obj);
+	// Stop moving objects that would touch another one during the next
+	// frame, at their time of impact (see igl::CollisionDetector). Trees of
+	// meshes deformed since the last frame are refitted first. The bounds
+	// of each object and the colliding triangles are drawn as boxes for
+	// this frame.
+	void check_and_handle_intersections();
 	~SandBox();
 	void Init(const std::string& config);
 	double doubleVariable;
 private:
+	igl::CollisionDetector collisions;
+	std::vector<const Eigen::MatrixXd*> vertices;
+	std::vector<const Eigen::MatrixXi*> faces;
+	igl::CollisionDetector::Transforms transforms;
+	std::vector<Eigen::Vector3d> displacements;
+	std::vector<double> impacts;
+	std::vector<igl::CollisionDetector::Contact> contacts;
+	// Object and triangle of the sides of the last contacts
+	std::vector<std::pair<int, int>> contact_faces;
 	// Prepare array-based edge data structures and priority queue
 
 
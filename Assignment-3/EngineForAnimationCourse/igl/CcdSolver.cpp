@@ -0,0 +1,43 @@
+#include "CcdSolver.h"
+#include "IKChain.h"
+#include "PI.h"
+#include <Eigen/Geometry>
+
+IGL_INLINE void igl::CcdSolver::iterate(IKChain& chain, const Eigen::Vector3d& target)
+{
+	const int n = chain.links();
+	const double min_bend = igl::PI / 6;
+	const Eigen::Vector3d z_axis = Eigen::Vector3d::UnitZ();
+	m_turns.assign(n, Eigen::Matrix3d::Identity());
+	Eigen::Vector3d end = chain.end_effector();
+	for (int i = n - 1; i >= 0; i--)
+	{
+		if ((end - target).norm() < m_tolerance)
+			break;
+		// The links before i have not turned yet, so joint i and the frames
+		// up to i are where the chain had them
+		const Eigen::Vector3d& joint = chain.m_joints[i];
+		const Eigen::Vector3d v1 = end - joint;
+		Eigen::Vector3d v2 = target - joint;
+		if (v2.isZero(0))
+			v2 = Eigen::Vector3d(0, 0, 0.01);
+		const Eigen::Vector3d axis = IKChain::turning_axis(v1, v2);
+		const Eigen::Vector3d local_axis = chain.m_frames[i].transpose() * axis;
+		double angle = m_step * IKChain::angle_between(v1, v2);
+		if (m_limited)
+		{
+			// Rotation relative to the parent once turned
+			const Eigen::Matrix3d relative = (i > 0 ? Eigen::Matrix3d(chain.m_frames[i - 1].transpose() * chain.m_frames[i]) : chain.m_frames[i])
+				* Eigen::AngleAxisd(angle, local_axis).toRotationMatrix();
+			const double alpha = IKChain::angle_between(-(relative.transpose() * z_axis), z_axis);
+			if (alpha < min_bend)
+				angle = angle > 0.0 ? angle - (min_bend - alpha) : angle + (min_bend - alpha);
+		}
+		m_turns[i] = Eigen::AngleAxisd(angle, local_axis).toRotationMatrix();
+		end = joint + Eigen::AngleAxisd(angle, axis) * v1;
+	}
+	chain.turn_links([&](const int i)
+	{
+		return m_turns[i];
+	});
+}
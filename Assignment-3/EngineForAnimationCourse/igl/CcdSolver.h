@@ -0,0 +1,44 @@
+#ifndef IGL_CCD_SOLVER_H
+#define IGL_CCD_SOLVER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+    class IKChain;
+    // Cyclic Coordinate Descent over an IKChain
+    //
+    // Each link in turn, from the end effector back to the base, is turned
+    // about its joint so that the end effector points at the target. Only
+    // the end effector is followed while turning; the other joints are
+    // moved in one pass at the end (IKChain::turn_links).
+    class CcdSolver
+    {
+    public:
+        CcdSolver() : m_step(1), m_limited(false), m_tolerance(0) {}
+        // One iteration
+        //
+        // Inputs:
+        //   chain  chain to turn towards target
+        //   target  place for the end effector, in the world
+        // Outputs:
+        //   chain  with its links turned
+        IGL_INLINE void iterate(IKChain& chain, const Eigen::Vector3d& target);
+
+        // Fraction of the angle to the target the links are turned by
+        double m_step;
+        // Whether a link may not fold closer than 30 degrees to its parent
+        bool m_limited;
+        // Distance to the target at which the remaining links are left
+        double m_tolerance;
+
+    private:
+        // Rotation of each link in its frame
+        std::vector<Eigen::Matrix3d> m_turns;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "CcdSolver.cpp"
+#endif
+#endif
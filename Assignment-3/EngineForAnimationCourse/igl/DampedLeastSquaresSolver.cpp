@@ -0,0 +1,43 @@
+#include "DampedLeastSquaresSolver.h"
+#include "IKChain.h"
+#include <Eigen/Cholesky>
+#include <Eigen/Geometry>
+#include <algorithm>
+
+IGL_INLINE bool igl::DampedLeastSquaresSolver::iterate(IKChain& chain, const Eigen::Vector3d& target)
+{
+	const int n = chain.links();
+	const Eigen::Vector3d end = chain.end_effector();
+	const Eigen::Vector3d error = target - end;
+
+	Eigen::Matrix3d JJt = Eigen::Matrix3d::Zero();
+	for (int j = 0; j < n; j++)
+	{
+		const Eigen::Vector3d r = end - chain.m_joints[j];
+		JJt += r.squaredNorm() * Eigen::Matrix3d::Identity() - r * r.transpose();
+	}
+	const Eigen::Vector3d y = (JJt + m_damping * m_damping * Eigen::Matrix3d::Identity()).ldlt().solve(error);
+	m_turns.resize(n);
+	for (int j = 0; j < n; j++)
+		m_turns[j] = chain.m_frames[j].transpose() * (end - chain.m_joints[j]).cross(y);
+
+	m_joints.assign(chain.m_joints.begin(), chain.m_joints.end());
+	m_frames.assign(chain.m_frames.begin(), chain.m_frames.end());
+	m_rotations.assign(chain.m_rotations.begin(), chain.m_rotations.end());
+	chain.turn_links([&](const int i)
+	{
+		const double angle = m_turns[i].norm();
+		return angle > 0 ? Eigen::AngleAxisd(angle, m_turns[i] / angle).toRotationMatrix() : Eigen::Matrix3d::Identity();
+	});
+
+	if ((target - chain.end_effector()).norm() < error.norm())
+	{
+		m_damping = std::max(0.5 * m_damping, m_min_damping);
+		return true;
+	}
+	chain.m_joints.swap(m_joints);
+	chain.m_frames.swap(m_frames);
+	chain.m_rotations.swap(m_rotations);
+	m_damping = std::min(4 * m_damping, m_max_damping);
+	return false;
+}
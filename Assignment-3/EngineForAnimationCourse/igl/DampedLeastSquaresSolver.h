@@ -0,0 +1,54 @@
+#ifndef IGL_DAMPED_LEAST_SQUARES_SOLVER_H
+#define IGL_DAMPED_LEAST_SQUARES_SOLVER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+    class IKChain;
+    // Damped least squares (Levenberg-Marquardt) inverse kinematics over an
+    // IKChain, with a ball joint of three rotations per link
+    //
+    // The Jacobian of the end effector e with respect to small rotations w
+    // of joint j about the world axes is w -> w x (e - p_j). With
+    // r_j = e - p_j, J J^T is the sum of |r_j|^2 I - r_j r_j^T, so the step
+    //   w_j = J^T (J J^T + lambda^2 I)^-1 (target - e) = r_j x y
+    // only needs a 3 by 3 solve for y and is linear in the number of links,
+    // without forming J.
+    //
+    // lambda adapts: it halves after a step that gets closer to the
+    // target, and a step that does not is undone and lambda grows four
+    // times. The joint limit of the other solvers is not enforced.
+    class DampedLeastSquaresSolver
+    {
+    public:
+        DampedLeastSquaresSolver() : m_damping(0.5), m_min_damping(1e-3), m_max_damping(1e3) {}
+        // One iteration
+        //
+        // Inputs:
+        //   chain  chain to turn towards target
+        //   target  place for the end effector, in the world
+        // Outputs:
+        //   chain  with its links turned, unless the step was undone
+        // Returns whether the step was kept
+        IGL_INLINE bool iterate(IKChain& chain, const Eigen::Vector3d& target);
+
+        // lambda, in units of length, and its range
+        double m_damping;
+        double m_min_damping;
+        double m_max_damping;
+
+    private:
+        // Rotation of each link in its frame, as angle times axis
+        std::vector<Eigen::Vector3d> m_turns;
+        // The chain before the step
+        std::vector<Eigen::Vector3d> m_joints;
+        std::vector<Eigen::Matrix3d> m_frames;
+        std::vector<Eigen::Matrix3d> m_rotations;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "DampedLeastSquaresSolver.cpp"
+#endif
+#endif
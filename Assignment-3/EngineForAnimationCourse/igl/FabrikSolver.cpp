@@ -0,0 +1,50 @@
+#include "FabrikSolver.h"
+#include "IKChain.h"
+#include "PI.h"
+#include <Eigen/Geometry>
+
+IGL_INLINE void igl::FabrikSolver::iterate(IKChain& chain, const Eigen::Vector3d& target)
+{
+	const int n = chain.links();
+	const double min_bend = igl::PI / 6;
+	std::vector<Eigen::Vector3d>& p = m_positions;
+	p.assign(chain.m_joints.begin(), chain.m_joints.end());
+
+	// Backward, from the target
+	p[n] = target;
+	for (int i = n - 1; i >= 0; i--)
+	{
+		const double lambda = chain.m_lengths[i] / (p[i + 1] - p[i]).norm();
+		p[i] = (1 - lambda) * p[i + 1] + lambda * p[i];
+		if (m_limited && i != n - 1)
+		{
+			Eigen::Vector3d next_link = p[i + 2] - p[i + 1];
+			const Eigen::Vector3d link = p[i] - p[i + 1];
+			if (IKChain::angle_between(next_link, link) < min_bend)
+			{
+				if (next_link.isZero(0))
+					next_link = Eigen::Vector3d(0, 0, 0.01);
+				p[i] = p[i + 1] + Eigen::AngleAxisd(min_bend, IKChain::turning_axis(next_link, link)) * next_link;
+			}
+		}
+	}
+
+	// Forward, from the base
+	p[0] = chain.base();
+	for (int i = 0; i < n; i++)
+	{
+		const double lambda = chain.m_lengths[i] / (p[i + 1] - p[i]).norm();
+		p[i + 1] = (1 - lambda) * p[i] + lambda * p[i + 1];
+	}
+
+	// Turn each link towards the new place of its end
+	chain.turn_links([&](const int i)
+	{
+		const Eigen::Vector3d v1 = chain.m_joints[i + 1] - chain.m_joints[i];
+		Eigen::Vector3d v2 = p[i + 1] - chain.m_joints[i];
+		if (v2.isZero(0))
+			v2 = Eigen::Vector3d(0, 0, 0.01);
+		const Eigen::Vector3d axis = chain.m_frames[i].transpose() * IKChain::turning_axis(v1, v2);
+		return Eigen::Matrix3d(Eigen::AngleAxisd(m_step * IKChain::angle_between(v1, v2), axis));
+	});
+}
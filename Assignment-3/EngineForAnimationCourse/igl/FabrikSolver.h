@@ -0,0 +1,42 @@
+#ifndef IGL_FABRIK_SOLVER_H
+#define IGL_FABRIK_SOLVER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+    class IKChain;
+    // Forward And Backward Reaching Inverse Kinematics over an IKChain
+    //
+    // The joints are placed on one contiguous buffer: from the target back
+    // to the base, then from the base forward, keeping the lengths of the
+    // links. The links are then turned towards the new places in one pass
+    // from the base (IKChain::turn_links), so an iteration is linear in the
+    // number of links. The buffer is kept between iterations.
+    class FabrikSolver
+    {
+    public:
+        FabrikSolver() : m_step(1), m_limited(false) {}
+        // One iteration
+        //
+        // Inputs:
+        //   chain  chain to turn towards target
+        //   target  place for the end effector, in the world
+        // Outputs:
+        //   chain  with its links turned
+        IGL_INLINE void iterate(IKChain& chain, const Eigen::Vector3d& target);
+
+        // Fraction of the angle to the new places the links are turned by
+        double m_step;
+        // Whether two links may not fold closer than 30 degrees apart
+        bool m_limited;
+
+    private:
+        std::vector<Eigen::Vector3d> m_positions;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "FabrikSolver.cpp"
+#endif
+#endif
@@ -0,0 +1,51 @@
+#include "IKChain.h"
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+
+IGL_INLINE void igl::IKChain::resize(const int links)
+{
+	m_joints.resize(links + 1);
+	m_frames.resize(links);
+	m_lengths.resize(links);
+	m_rotations.resize(links);
+}
+
+IGL_INLINE void igl::IKChain::set_link(
+	const int i,
+	const Eigen::Matrix4d& world,
+	const Eigen::Vector3d& joint,
+	const Eigen::Vector3d& tip)
+{
+	// The next link sets the end of this one again, at the same place
+	m_joints[i] = world.topLeftCorner<3, 3>() * joint + world.topRightCorner<3, 1>();
+	m_joints[i + 1] = world.topLeftCorner<3, 3>() * tip + world.topRightCorner<3, 1>();
+	m_frames[i] = world.topLeftCorner<3, 3>();
+	m_lengths[i] = (tip - joint).norm();
+	m_rotations[i].setIdentity();
+}
+
+IGL_INLINE double igl::IKChain::reach() const
+{
+	double sum = 0;
+	for (double length : m_lengths)
+		sum += length;
+	return sum;
+}
+
+IGL_INLINE double igl::IKChain::angle_between(const Eigen::Vector3d& v1, const Eigen::Vector3d& v2)
+{
+	const double cos_angle = v1.dot(v2) / (v1.norm() * v2.norm());
+	return std::acos(std::max(std::min(cos_angle, 1.0), -1.0));
+}
+
+IGL_INLINE Eigen::Vector3d igl::IKChain::turning_axis(const Eigen::Vector3d& v1, const Eigen::Vector3d& v2)
+{
+	if (v1.normalized() == v2.normalized() || v1.normalized() == -v2.normalized())
+	{
+		if (v1.x() != 0 || v1.y() != 0)
+			return Eigen::Vector3d(v1.y(), -v1.x(), 0).normalized();
+		return Eigen::Vector3d(1, 0, 0);
+	}
+	return v1.cross(v2).normalized();
+}
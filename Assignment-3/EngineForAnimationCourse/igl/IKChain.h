@@ -0,0 +1,100 @@
+#ifndef IGL_IK_CHAIN_H
+#define IGL_IK_CHAIN_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <vector>
+namespace igl
+{
+    // A chain of rigid links joined by ball joints, as seen by the inverse
+    // kinematics solvers (FabrikSolver, CcdSolver and
+    // DampedLeastSquaresSolver). Link i turns about joint i and
+    // ends at joint i + 1, the last joint is the end effector.
+    //
+    // Solvers work on this copy of the chain rather than on the objects of
+    // the scene. As they turn links they move the joints and frames after
+    // them, and keep the rotation of each link in its own frame, to be
+    // applied to the objects once at the end (Movable::MyRotate). Storage
+    // is kept from one frame to the next.
+    class IKChain
+    {
+    public:
+        // Set the number of links, keeping the storage when it does not grow
+        IGL_INLINE void resize(const int links);
+        // Set link i from its place in the world, and clear its rotation
+        //
+        // Inputs:
+        //   world  transform from the coordinates of the link to the world
+        //   joint  point the link turns about, in its coordinates
+        //   tip  end of the link, in its coordinates
+        IGL_INLINE void set_link(
+            const int i,
+            const Eigen::Matrix4d& world,
+            const Eigen::Vector3d& joint,
+            const Eigen::Vector3d& tip);
+        // Turn the links from the base to the end effector, each by the
+        // rotation turn(i) returns, in the frame of link i. When turn(i) is
+        // called the links before i are turned already, and m_joints[i + 1]
+        // is at the end of link i. One pass, linear in the number of links.
+        template <typename Turn>
+        void turn_links(const Turn& turn);
+
+        int links() const { return m_lengths.size(); }
+        const Eigen::Vector3d& base() const { return m_joints.front(); }
+        const Eigen::Vector3d& end_effector() const { return m_joints.back(); }
+        // Longest distance from the base the end effector gets to
+        IGL_INLINE double reach() const;
+
+        // Angle between two vectors, in [0, pi]
+        IGL_INLINE static double angle_between(const Eigen::Vector3d& v1, const Eigen::Vector3d& v2);
+        // Unit axis to turn v1 about towards v2, one perpendicular to v1 if
+        // they are parallel
+        IGL_INLINE static Eigen::Vector3d turning_axis(const Eigen::Vector3d& v1, const Eigen::Vector3d& v2);
+        // Make a rotation that drifted from products orthonormal again
+        static void orthonormalize(Eigen::Matrix3d& rotation)
+        {
+            rotation.col(0).normalize();
+            rotation.col(1) = (rotation.col(1) - rotation.col(0).dot(rotation.col(1)) * rotation.col(0)).normalized();
+            rotation.col(2) = rotation.col(0).cross(rotation.col(1));
+        }
+
+        // #links + 1 positions of the joints in the world
+        std::vector<Eigen::Vector3d> m_joints;
+        // #links rotations from the frames of the links to the world
+        std::vector<Eigen::Matrix3d> m_frames;
+        // #links lengths of the links
+        std::vector<double> m_lengths;
+        // #links rotations of the links in their own frames since set_link()
+        std::vector<Eigen::Matrix3d> m_rotations;
+    };
+}
+
+template <typename Turn>
+void igl::IKChain::turn_links(const Turn& turn)
+{
+    // Rotation of the links after i from where they were, in the world.
+    // Taken from the frames rather than by multiplying world rotations,
+    // which would grow the rounding errors with every link.
+    Eigen::Matrix3d turned = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d old_joint = m_joints[0];
+    for (int i = 0; i < links(); i++)
+    {
+        const Eigen::Vector3d old_next = m_joints[i + 1];
+        const Eigen::Matrix3d old_frame = m_frames[i];
+        m_frames[i] = turned * old_frame;
+        m_joints[i + 1] = m_joints[i] + turned * (old_next - old_joint);
+        const Eigen::Matrix3d rotation = turn(i);
+        m_frames[i] = m_frames[i] * rotation;
+        m_rotations[i] = m_rotations[i] * rotation;
+        orthonormalize(m_frames[i]);
+        orthonormalize(m_rotations[i]);
+        turned = m_frames[i] * old_frame.transpose();
+        m_joints[i + 1] = m_joints[i] + turned * (old_next - old_joint);
+        old_joint = old_next;
+    }
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "IKChain.cpp"
+#endif
+#endif
@@ -0,0 +1,71 @@
+#include "IKCrowd.h"
+
+IGL_INLINE igl::IKCrowd::IKCrowd(const int num_threads) :
+	m_workers(num_threads),
+	m_solvers(m_workers.size())
+{
+}
+
+IGL_INLINE int igl::IKCrowd::add_chain(const int first, const int links)
+{
+	m_first.push_back(first);
+	m_links.push_back(links);
+	m_chains.emplace_back();
+	m_chains.back().resize(links);
+	m_targets.push_back(Eigen::Vector3d::Zero());
+	m_damping.push_back(m_dls.m_damping);
+	m_moved.push_back(0);
+	m_reports.emplace_back();
+	return m_first.size() - 1;
+}
+
+IGL_INLINE void igl::IKCrowd::clear()
+{
+	m_first.clear();
+	m_links.clear();
+	m_chains.clear();
+	m_targets.clear();
+	m_damping.clear();
+	m_moved.clear();
+	m_reports.clear();
+}
+
+IGL_INLINE void igl::IKCrowd::solve(
+	const Method method,
+	const std::function<bool(int, IKChain&)>& load)
+{
+	// Only the settings, the threads keep their scratch
+	for (Solvers& solvers : m_solvers)
+	{
+		solvers.ccd.m_step = m_ccd.m_step;
+		solvers.ccd.m_limited = m_ccd.m_limited;
+		solvers.ccd.m_tolerance = m_ccd.m_tolerance;
+		solvers.fabrik.m_step = m_fabrik.m_step;
+		solvers.fabrik.m_limited = m_fabrik.m_limited;
+		solvers.dls.m_min_damping = m_dls.m_min_damping;
+		solvers.dls.m_max_damping = m_dls.m_max_damping;
+	}
+	m_workers.run(chains(), [&](const int c, const int t)
+	{
+		IKChain& chain = m_chains[c];
+		chain.resize(m_links[c]);
+		m_moved[c] = load(c, chain);
+		if (!m_moved[c])
+			return;
+		Solvers& solvers = m_solvers[t];
+		switch (method)
+		{
+		case CCD:
+			m_reports[c] = m_driver.solve(solvers.ccd, chain, m_targets[c]);
+			break;
+		case FABRIK:
+			m_reports[c] = m_driver.solve(solvers.fabrik, chain, m_targets[c]);
+			break;
+		case DLS:
+			solvers.dls.m_damping = m_damping[c];
+			m_reports[c] = m_driver.solve(solvers.dls, chain, m_targets[c]);
+			m_damping[c] = solvers.dls.m_damping;
+			break;
+		}
+	});
+}
@@ -0,0 +1,98 @@
+#ifndef IGL_IK_CROWD_H
+#define IGL_IK_CROWD_H
+#include "igl_inline.h"
+#include "IKChain.h"
+#include "IKDriver.h"
+#include "CcdSolver.h"
+#include "FabrikSolver.h"
+#include "DampedLeastSquaresSolver.h"
+#include "WorkerPool.h"
+#include <Eigen/Core>
+#include <functional>
+#include <vector>
+namespace igl
+{
+    // Inverse kinematics for many independent chains, each with its own
+    // target, solved at once on a WorkerPool.
+    //
+    // A chain is registered as a contiguous range of links of the scene
+    // (the objects first to first + links - 1, each hanging from the one
+    // before). Every solve() loads each chain through a callback, runs
+    // IKDriver on it with the chosen solver, and leaves the rotations in
+    // chain(c).m_rotations for the caller to apply to the objects. Chains
+    // are handed out to the threads one at a time, so a few long or far
+    // chains do not hold back the others. Each thread has its own solvers
+    // and each chain its own storage, kept from one frame to the next.
+    class IKCrowd
+    {
+    public:
+        enum Method { CCD, FABRIK, DLS };
+
+        // Inputs:
+        //   num_threads  number of threads including the caller, 0 for one
+        //     per hardware thread
+        IGL_INLINE explicit IKCrowd(const int num_threads = 0);
+        // Register the chain of the links first to first + links - 1,
+        // with its target at the origin
+        //
+        // Returns the index of the chain
+        IGL_INLINE int add_chain(const int first, const int links);
+        IGL_INLINE void clear();
+
+        int chains() const { return m_first.size(); }
+        int first(const int c) const { return m_first[c]; }
+        int links(const int c) const { return m_links[c]; }
+        void set_target(const int c, const Eigen::Vector3d& target) { m_targets[c] = target; }
+        const Eigen::Vector3d& target(const int c) const { return m_targets[c]; }
+        IKChain& chain(const int c) { return m_chains[c]; }
+        // Whether chain c was solved by the last solve()
+        bool moved(const int c) const { return m_moved[c] != 0; }
+        // Of the last solve() of chain c, when moved(c)
+        const IKDriver::Report& report(const int c) const { return m_reports[c]; }
+
+        // Solve all the chains. For each chain c, load(c, chain(c)) sets
+        // the links of the chain (IKChain::set_link) and returns whether
+        // to solve it. load is called on the threads of the pool, several
+        // at a time, so it must only read the scene.
+        //
+        // Inputs:
+        //   method  solver to run on the chains
+        //   load  callback setting chain c
+        IGL_INLINE void solve(
+            const Method method,
+            const std::function<bool(int, IKChain&)>& load);
+
+        // Settings of the solvers and the driver, for every chain. The
+        // damping of m_dls is the one new chains start with; it then
+        // adapts on each chain.
+        CcdSolver m_ccd;
+        FabrikSolver m_fabrik;
+        DampedLeastSquaresSolver m_dls;
+        IKDriver m_driver;
+
+    private:
+        struct Solvers
+        {
+            CcdSolver ccd;
+            FabrikSolver fabrik;
+            DampedLeastSquaresSolver dls;
+        };
+
+        WorkerPool m_workers;
+        // Per thread
+        std::vector<Solvers> m_solvers;
+        // Per chain
+        std::vector<int> m_first;
+        std::vector<int> m_links;
+        std::vector<IKChain> m_chains;
+        std::vector<Eigen::Vector3d> m_targets;
+        std::vector<double> m_damping;
+        std::vector<char> m_moved;
+        std::vector<IKDriver::Report> m_reports;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "IKCrowd.cpp"
+#endif
+#endif
@@ -0,0 +1,89 @@
+#ifndef IGL_IK_DRIVER_H
+#define IGL_IK_DRIVER_H
+#include "IKChain.h"
+#include "get_seconds.h"
+#include <Eigen/Core>
+#include <limits>
+namespace igl
+{
+    // Runs an inverse kinematics solver (CcdSolver, FabrikSolver or
+    // DampedLeastSquaresSolver) on a chain until the end effector is within
+    // the tolerance of the target, the iteration cap is hit, or the time
+    // budget runs out, so a frame of animation gets as close as it can in a
+    // bounded time whatever the frame rate.
+    //
+    // The budget is checked between iterations: another iteration is run
+    // only if, taking as long as the mean one so far, it ends within the
+    // budget. The first iteration always runs.
+    class IKDriver
+    {
+    public:
+        enum Stop { CONVERGED, MAX_ITERATIONS, BUDGET };
+        struct Report
+        {
+            Stop stop;
+            int iterations;
+            // Distance from the end effector to the target at the end
+            double error;
+            double microseconds;
+        };
+
+        IKDriver() :
+            m_tolerance(0.1),
+            m_max_iterations(100),
+            m_budget(std::numeric_limits<double>::infinity()) {}
+        // Inputs:
+        //   solver  solver to run, with an iterate(chain, target) method
+        //   chain  chain to turn towards target
+        //   target  place for the end effector, in the world
+        // Outputs:
+        //   chain  with its links turned
+        // Returns why it stopped, the iterations run, the error left and
+        // the time spent
+        template <typename Solver>
+        Report solve(Solver& solver, IKChain& chain, const Eigen::Vector3d& target) const;
+
+        // Distance to the target at which the end effector is there
+        double m_tolerance;
+        int m_max_iterations;
+        // Time per solve in microseconds, infinity for none
+        double m_budget;
+    };
+}
+
+template <typename Solver>
+igl::IKDriver::Report igl::IKDriver::solve(
+    Solver& solver,
+    IKChain& chain,
+    const Eigen::Vector3d& target) const
+{
+    Report report;
+    report.iterations = 0;
+    report.microseconds = 0;
+    const double start = get_seconds();
+    while (true)
+    {
+        report.error = (chain.end_effector() - target).norm();
+        if (report.error < m_tolerance)
+        {
+            report.stop = CONVERGED;
+            break;
+        }
+        if (report.iterations >= m_max_iterations)
+        {
+            report.stop = MAX_ITERATIONS;
+            break;
+        }
+        if (report.iterations > 0 && report.microseconds * (report.iterations + 1) / report.iterations > m_budget)
+        {
+            report.stop = BUDGET;
+            break;
+        }
+        solver.iterate(chain, target);
+        report.iterations++;
+        report.microseconds = 1e6 * (get_seconds() - start);
+    }
+    return report;
+}
+
+#endif
@@ -1,15 +1,40 @@
 #include "Movable.h"
+#include "SceneGraph.h"
 #include <iostream>
 Movable::Movable()
 {
 	Tout = Eigen::Affine3d::Identity();
 	Tin = Eigen::Affine3d::Identity();
+	graph = nullptr;
+	node = -1;
 }
 
 Movable::Movable(const Movable &mov)
 {
 	Tout = mov.Tout;
 	Tin = mov.Tin;
+	graph = nullptr;
+	node = -1;
+}
+
+Movable &Movable::operator=(const Movable &mov)
+{
+	Tout = mov.Tout;
+	Tin = mov.Tin;
+	Moved();
+	return *this;
+}
+
+void Movable::LinkTo(SceneGraph *graph, int node)
+{
+	this->graph = graph;
+	this->node = node;
+}
+
+void Movable::Moved()
+{
+	if (graph)
+		graph->Moved(node);
 }
 
 Eigen::Matrix4f Movable::MakeTransScale()
@@ -37,29 +62,34 @@ void Movable::MyTranslate(Eigen::Vector3d amt, bool preRotation)
 		Tout.pretranslate(amt);
 	else
 		Tout.translate(amt);
+	Moved();
 }
 
 void Movable::TranslateInSystem(Eigen::Matrix3d rot, Eigen::Vector3d amt)
 {
 	Tout.pretranslate(rot.transpose() * amt);
+	Moved();
 }
 
 void Movable::SetCenterOfRotation(Eigen::Vector3d amt)
 {
 	Tin.pretranslate(-amt);
 	Tout.pretranslate(amt);
+	Moved();
 }
 
 // angle in radians
 void Movable::MyRotate(Eigen::Vector3d rotAxis, double angle)
 {
 	Tout.rotate(Eigen::AngleAxisd(angle, rotAxis.normalized()));
+	Moved();
 }
 
 void Movable::RotateInSystem(Eigen::Matrix3d preRot, Eigen::Vector3d rotAxis, double angle)
 {
 	// counter rotate a third party rotation, and then counter previous self rotation
 	Tout.rotate(Eigen::AngleAxisd(angle, Tout.rotation().transpose() * preRot.transpose() * rotAxis.normalized()));
+	Moved();
 }
 
 double calcAngle(Eigen::Vector3d v1, Eigen::Vector3d v2)
@@ -97,16 +127,19 @@ void Movable::EulerRotation(Eigen::Vector3d rotAxis, double angle, bool limit)
 	}
 	res = GetRotation().transpose() * res;
 	Tout.rotate(res);
+	Moved();
 }
 
 void Movable::MyRotate(const Eigen::Matrix3d &rot)
 {
 	Tout.rotate(rot);
+	Moved();
 }
 
 void Movable::MyScale(Eigen::Vector3d amt)
 {
 	Tin.scale(amt);
+	Moved();
 }
 
 // void Movable::TranslateInSystem(Eigen::Matrix4d Mat, Eigen::Vector3d amt, bool preRotation)
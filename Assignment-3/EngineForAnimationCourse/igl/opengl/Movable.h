@@ -3,12 +3,15 @@
 #include <Eigen/Geometry>
 #include <Eigen/dense>
 
+class SceneGraph;
 
 class Movable
 {
 public:
 	Movable();
+	// Copies are not linked to the scene graph of mov
 	Movable(const Movable& mov);
+	Movable& operator=(const Movable& mov);
 	Eigen::Matrix4f MakeTransScale();
 	Eigen::Matrix4d MakeTransd();
 	Eigen::Matrix4d MakeTransScaled();
@@ -24,8 +27,15 @@ public:
 	Eigen::Matrix3d GetRotation() const{ return Tout.rotation().matrix(); }
 	Eigen::Vector3d GetTranslation() const { return Tout.translation(); }
 
+	// Tell graph whenever this object moves, as its node
+	void LinkTo(SceneGraph* graph, int node);
+
 	virtual ~Movable() {}
 private:
+	void Moved();
+
 	Eigen::Affine3d Tout,Tin;
+	SceneGraph* graph;
+	int node;
 };
 
@@ -0,0 +1,95 @@
+#include "SceneGraph.h"
+#include "Movable.h"
+#include <algorithm>
+
+SceneGraph::SceneGraph()
+{
+	identity = Eigen::Matrix4d::Identity();
+}
+
+void SceneGraph::Build(const std::vector<Movable*>& objects, const std::vector<int>& parents)
+{
+	this->objects = objects;
+	this->parents = parents;
+	const int n = std::max(objects.size(), parents.size());
+	for (int i = 0; i < int(objects.size()); i++)
+		objects[i]->LinkTo(this, i);
+
+	// Children of each node, counted and then placed
+	first_child.assign(n + 1, 0);
+	for (int i = 0; i < n; i++)
+		if (Parent(i) >= 0)
+			first_child[Parent(i) + 1]++;
+	for (int i = 0; i < n; i++)
+		first_child[i + 1] += first_child[i];
+	children.resize(first_child[n]);
+	std::vector<int> next(first_child.begin(), first_child.end() - 1);
+	for (int i = 0; i < n; i++)
+		if (Parent(i) >= 0)
+			children[next[Parent(i)]++] = i;
+
+	// Roots first, then breadth first
+	order.clear();
+	for (int i = 0; i < n; i++)
+		if (Parent(i) < 0)
+			order.push_back(i);
+	for (int k = 0; k < int(order.size()); k++)
+		order.insert(order.end(), children.begin() + first_child[order[k]], children.begin() + first_child[order[k] + 1]);
+
+	world.assign(n, identity);
+	dirty.assign(n, 1);
+}
+
+void SceneGraph::Moved(int node)
+{
+	// Subtrees of dirty nodes are dirty already
+	if (node >= int(dirty.size()) || dirty[node])
+		return;
+	stack.clear();
+	stack.push_back(node);
+	while (!stack.empty())
+	{
+		const int i = stack.back();
+		stack.pop_back();
+		dirty[i] = 1;
+		for (int k = first_child[i]; k < first_child[i + 1]; k++)
+			if (!dirty[children[k]])
+				stack.push_back(children[k]);
+	}
+}
+
+void SceneGraph::Update()
+{
+	for (int i : order)
+		if (dirty[i])
+			Compute(i);
+}
+
+const Eigen::Matrix4d& SceneGraph::World(int node)
+{
+	if (dirty[node])
+	{
+		// The dirty ancestors, from the node up
+		stack.clear();
+		for (int i = node; i >= 0 && dirty[i]; i = Parent(i))
+			stack.push_back(i);
+		for (int k = stack.size() - 1; k >= 0; k--)
+			Compute(stack[k]);
+	}
+	return world[node];
+}
+
+const Eigen::Matrix4d& SceneGraph::ParentWorld(int node)
+{
+	return Parent(node) >= 0 ? World(Parent(node)) : identity;
+}
+
+void SceneGraph::Compute(int node)
+{
+	const int parent = Parent(node);
+	if (node < int(objects.size()))
+		world[node] = (parent >= 0 ? world[parent] : identity) * objects[node]->MakeTransd();
+	else
+		world[node] = parent >= 0 ? world[parent] : identity;
+	dirty[node] = 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <Eigen/Core>
+#include <vector>
+
+class Movable;
+
+// Caches the world transform of every object of a hierarchy, where the
+// world transform of a node is the one of its parent times its own
+// MakeTransd().
+//
+// The objects tell the graph when they move (see Movable), which marks
+// them and everything below them dirty. A dirty transform is computed
+// again when asked for, or by Update(), which goes over the nodes once,
+// parents first. So a frame costs one product per node that moved or
+// hangs from one that did, instead of one per ancestor of every node.
+class SceneGraph
+{
+public:
+	SceneGraph();
+	// Link objects[i] to node i, which hangs from node parents[i] (-1 for
+	// roots). There may be more parents than objects: the nodes after the
+	// last object have an identity transform, like the tip of a chain.
+	// Objects linked by an earlier Build() are not touched, they may be
+	// gone already; if they move they only mark nodes dirty for nothing.
+	// The objects must not move once the graph is destroyed.
+	void Build(const std::vector<Movable*>& objects, const std::vector<int>& parents);
+
+	// Mark node and its subtree dirty
+	void Moved(int node);
+	// Compute all dirty transforms again
+	void Update();
+	// Transform from the frame of node to the world
+	const Eigen::Matrix4d& World(int node);
+	// World transform of the parent of node, identity for roots
+	const Eigen::Matrix4d& ParentWorld(int node);
+
+	int Size() const { return world.size(); }
+	const std::vector<Movable*>& Objects() const { return objects; }
+	const std::vector<int>& Parents() const { return parents; }
+
+private:
+	SceneGraph(const SceneGraph&);
+	SceneGraph& operator=(const SceneGraph&);
+	int Parent(int node) const { return node < int(parents.size()) ? parents[node] : -1; }
+	void Compute(int node);
+
+	std::vector<Movable*> objects;
+	std::vector<int> parents;
+	// Children of node i are children[first_child[i]] to
+	// children[first_child[i + 1] - 1]
+	std::vector<int> first_child;
+	std::vector<int> children;
+	// Nodes ordered parents first
+	std::vector<int> order;
+	std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d> > world;
+	std::vector<char> dirty;
+	// Scratch of Moved() and World()
+	std::vector<int> stack;
+	Eigen::Matrix4d identity;
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
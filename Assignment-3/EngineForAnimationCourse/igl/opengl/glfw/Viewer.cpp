@@ -369,15 +369,42 @@ namespace igl
 
 			Eigen::Matrix4d Viewer::CalcParentsTrans(int indx)
 			{
-				Eigen::Matrix4d prevTrans = Eigen::Matrix4d::Identity();
+				if (!IsSceneGraphLinked())
+					UpdateTransforms();
+				assert(scene_graph.Parents() == parents && "call UpdateTransforms() after changing parents");
+				return scene_graph.ParentWorld(indx);
+			}
 
-				for (int i = indx; parents[i] >= 0; i = parents[i])
+			const Eigen::Matrix4d &Viewer::CalcWorldTrans(int indx)
+			{
+				if (!IsSceneGraphLinked())
+					UpdateTransforms();
+				assert(scene_graph.Parents() == parents && "call UpdateTransforms() after changing parents");
+				return scene_graph.World(indx);
+			}
+
+			bool Viewer::IsSceneGraphLinked() const
+			{
+				// Meshes added or moved in memory, or parents resized, since the
+				// last frame. Parents changed in place are only caught by
+				// UpdateTransforms(), comparing them on every query would cost
+				// as much as the walk the graph saves.
+				return !data_list.empty() &&
+					   scene_graph.Objects().size() == data_list.size() &&
+					   scene_graph.Objects().front() == &data_list.front() &&
+					   scene_graph.Parents().size() == parents.size();
+			}
+
+			IGL_INLINE void Viewer::UpdateTransforms()
+			{
+				if (!IsSceneGraphLinked() || scene_graph.Parents() != parents)
 				{
-					// std::cout << "parent matrix:\n" << scn->data_list[scn->parents[i]].MakeTrans() << std::endl;
-					prevTrans = data_list[parents[i]].MakeTransd() * prevTrans;
+					std::vector<Movable *> objects(data_list.size());
+					for (size_t i = 0; i < data_list.size(); i++)
+						objects[i] = &data_list[i];
+					scene_graph.Build(objects, parents);
 				}
-
-				return prevTrans;
+				scene_graph.Update();
 			}
 		} // end namespace
 	}	  // end namespace
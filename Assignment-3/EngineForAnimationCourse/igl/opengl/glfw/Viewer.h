@@ -16,6 +16,7 @@
 #include "../MeshGL.h"
 
 #include "../ViewerData.h"
+#include "../SceneGraph.h"
 #include "ViewerPlugin.h"
 
 #include <Eigen/Core>
@@ -118,7 +119,15 @@ namespace igl
         // Returns 0 if not found
         IGL_INLINE size_t mesh_index(const int id) const;
 
+        // World transform of the parent of data_list[indx], the product of
+        // the MakeTransd() of its ancestors. Cached by scene_graph.
         Eigen::Matrix4d CalcParentsTrans(int indx);
+        // World transform of data_list[indx] itself
+        const Eigen::Matrix4d &CalcWorldTrans(int indx);
+        // Compute the world transforms of everything that moved, once per
+        // frame. Also links data_list and parents to scene_graph again when
+        // they changed.
+        IGL_INLINE void UpdateTransforms();
         inline bool SetAnimation() { return isActive = !isActive; }
 
       public:
@@ -131,6 +140,9 @@ namespace igl
         // Stores all the data that should be visualized
         std::vector<ViewerData> data_list;
 
+        // Parent of each mesh in data_list, -1 for roots; call
+        // UpdateTransforms() after changing it (asserted by the transform
+        // queries in debug builds)
         std::vector<int> parents;
         std::vector<int> links;
         Eigen::Vector3d link_tip;
@@ -152,6 +164,12 @@ namespace igl
         // Keep track of the global position of the scrollwheel
         float scroll_position;
 
+        // World transforms of data_list, after it so it goes first
+        SceneGraph scene_graph;
+
+      private:
+        bool IsSceneGraphLinked() const;
+
       public:
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
       };
@@ -60,6 +60,7 @@ IGL_INLINE void Renderer::draw( GLFWwindow* window)
 		core.clear_framebuffers();
 	}
 	int coreIndx = 1;
+	scn->UpdateTransforms();
 	if (menu)
 	{
 		menu->pre_draw();
@@ -0,0 +1,374 @@
+// Measures the inverse kinematics solvers on generated problems and writes
+// the results as JSON, to compare how fast they bring the arm of the
+// sandbox to its target.
+//
+// A problem is a chain of links of length 1.6 (the cylinders of the
+// sandbox) with its base at the origin, bent by small random angles, and a
+// random target within reach. Each solver starts from the same chain and
+// is run by igl::IKDriver, as in the sandbox, until the end effector is
+// within the tolerance of the target, the iteration cap is reached or the
+// time budget runs out:
+//   ccd     igl::CcdSolver
+//   fabrik  igl::FabrikSolver
+//   dls     igl::DampedLeastSquaresSolver
+// CCD and FABRIK turn the links by the given fraction of their angle. For
+// each solver the JSON has the problems solved and the ones stopped by the
+// budget, the iterations run (mean, median, max), the distance left, and
+// the time in total and per iteration.
+//
+// With -t the problems are solved at once as the chains of an
+// igl::IKCrowd, on the given number of threads, and the time is the one
+// of the whole solve (loading the chains included), to measure how the
+// throughput scales with the threads.
+//
+// Usage: ikBenchmark_bin [options]
+//   -n count   number of problems (default 200)
+//   -k count   links of the chain (default 4)
+//   -i count   iteration cap (default 1000)
+//   -b us      time budget per problem in microseconds (default none)
+//   -e dist    tolerance, as in the sandbox (default 0.1)
+//   -d step    fraction of the angle turned by CCD and FABRIK (default 1)
+//   -l         limit the bend between links to 30 degrees, as the 'b' key
+//   -s seed    seed of the problems (default 1)
+//   -p list    solvers to run (default all of the above)
+//   -t count   solve as a crowd on count threads, 0 for one per core
+//              (default: one problem at a time)
+//   -o file    output file (default: standard output)
+#include <igl/IKChain.h>
+#include <igl/CcdSolver.h>
+#include <igl/FabrikSolver.h>
+#include <igl/DampedLeastSquaresSolver.h>
+#include <igl/IKDriver.h>
+#include <igl/IKCrowd.h>
+#include <igl/get_seconds.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+const double link_length = 1.6;
+
+struct Problem
+{
+	// Rotation of each link relative to its parent
+	std::vector<Eigen::Matrix3d> bends;
+	Eigen::Vector3d target;
+};
+
+struct Result
+{
+	std::string solver;
+	int solved;
+	// Problems stopped by the time budget
+	int over_budget;
+	// Per problem
+	std::vector<int> iterations;
+	double sum_distance;
+	double seconds;
+};
+
+static bool parse_list(const std::string& arg, std::vector<std::string>& items)
+{
+	std::stringstream stream(arg);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (item.empty())
+			return false;
+		items.push_back(item);
+	}
+	return !items.empty();
+}
+
+static bool parse_count(const char* arg, const int min, int& count)
+{
+	char* end;
+	const long value = std::strtol(arg, &end, 10);
+	if (*end != '\0' || value < min || value > 1000000)
+		return false;
+	count = (int)value;
+	return true;
+}
+
+static bool parse_fraction(const char* arg, double& value)
+{
+	char* end;
+	value = std::strtod(arg, &end);
+	return *end == '\0' && value > 0 && value <= 1;
+}
+
+static std::vector<Problem> make_problems(const int n, const int links, const unsigned seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> uniform(-1, 1);
+	std::vector<Problem> problems(n);
+	for (auto& problem : problems)
+	{
+		for (int i = 0; i < links; i++)
+		{
+			const Eigen::Vector3d axis = Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator)).normalized();
+			problem.bends.push_back(Eigen::AngleAxisd(0.3 * uniform(generator), axis).toRotationMatrix());
+		}
+		// Between a fifth and all of the reach, not along the chain
+		Eigen::Vector3d direction;
+		do
+			direction = Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator));
+		while (direction.norm() > 1 || direction.norm() < 0.2);
+		problem.target = 0.95 * links * link_length * direction;
+	}
+	return problems;
+}
+
+// The chain of the problem, as SandBox::LoadChain sets it
+static void set_chain(const Problem& problem, igl::IKChain& chain)
+{
+	const int links = problem.bends.size();
+	const Eigen::Vector3d joint(0, 0, 0.5 * link_length);
+	const Eigen::Vector3d tip(0, 0, -0.5 * link_length);
+	chain.resize(links);
+	// The joint of the first link at the origin
+	Eigen::Affine3d world(Eigen::Translation3d(-joint));
+	for (int i = 0; i < links; i++)
+	{
+		// Turn about the joint, at the end of the parent
+		world.translate(joint).rotate(problem.bends[i]).translate(-joint);
+		chain.set_link(i, world.matrix(), joint, tip);
+		world.translate(tip - joint);
+	}
+}
+
+static Result run(
+	const std::string& solver,
+	const std::vector<Problem>& problems,
+	const igl::IKDriver& driver,
+	const double step,
+	const bool limited)
+{
+	Result res;
+	res.solver = solver;
+	res.solved = 0;
+	res.over_budget = 0;
+	res.sum_distance = 0;
+	res.seconds = 0;
+	igl::IKChain chain;
+	igl::CcdSolver ccd;
+	igl::FabrikSolver fabrik;
+	igl::DampedLeastSquaresSolver dls;
+	ccd.m_step = step;
+	ccd.m_limited = limited;
+	fabrik.m_step = step;
+	fabrik.m_limited = limited;
+	const double damping = dls.m_damping;
+	for (const auto& problem : problems)
+	{
+		set_chain(problem, chain);
+		dls.m_damping = damping;
+		igl::IKDriver::Report report;
+		if (solver == "ccd")
+			report = driver.solve(ccd, chain, problem.target);
+		else if (solver == "fabrik")
+			report = driver.solve(fabrik, chain, problem.target);
+		else
+			report = driver.solve(dls, chain, problem.target);
+		res.seconds += 1e-6 * report.microseconds;
+		res.solved += report.stop == igl::IKDriver::CONVERGED;
+		res.over_budget += report.stop == igl::IKDriver::BUDGET;
+		res.sum_distance += report.error;
+		res.iterations.push_back(report.iterations);
+	}
+	return res;
+}
+
+// The problems as the chains of one crowd, solved at once
+static Result run_crowd(
+	const std::string& solver,
+	const std::vector<Problem>& problems,
+	const igl::IKDriver& driver,
+	const double step,
+	const bool limited,
+	const int threads)
+{
+	Result res;
+	res.solver = solver;
+	res.solved = 0;
+	res.over_budget = 0;
+	res.sum_distance = 0;
+	igl::IKCrowd crowd(threads);
+	crowd.m_driver = driver;
+	crowd.m_ccd.m_step = step;
+	crowd.m_ccd.m_limited = limited;
+	crowd.m_fabrik.m_step = step;
+	crowd.m_fabrik.m_limited = limited;
+	for (const auto& problem : problems)
+	{
+		const int c = crowd.add_chain(0, problem.bends.size());
+		crowd.set_target(c, problem.target);
+	}
+	const igl::IKCrowd::Method method =
+		solver == "ccd" ? igl::IKCrowd::CCD :
+		solver == "fabrik" ? igl::IKCrowd::FABRIK :
+		igl::IKCrowd::DLS;
+	const double start = igl::get_seconds();
+	crowd.solve(method, [&](const int c, igl::IKChain& chain)
+	{
+		set_chain(problems[c], chain);
+		return true;
+	});
+	res.seconds = igl::get_seconds() - start;
+	for (int c = 0; c < crowd.chains(); c++)
+	{
+		const igl::IKDriver::Report& report = crowd.report(c);
+		res.solved += report.stop == igl::IKDriver::CONVERGED;
+		res.over_budget += report.stop == igl::IKDriver::BUDGET;
+		res.sum_distance += report.error;
+		res.iterations.push_back(report.iterations);
+	}
+	return res;
+}
+
+int main(int argc, char* argv[])
+{
+	int n = 200;
+	int links = 4;
+	int max_iterations = 1000;
+	double budget = std::numeric_limits<double>::infinity();
+	double tolerance = 0.1;
+	double step = 1;
+	bool limited = false;
+	int seed = 1;
+	// -1 for one problem at a time
+	int threads = -1;
+	std::vector<std::string> solvers;
+	std::string output;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		bool ok = true;
+		if (arg == "-n" && has_value)
+			ok = parse_count(argv[++i], 1, n);
+		else if (arg == "-k" && has_value)
+			ok = parse_count(argv[++i], 1, links);
+		else if (arg == "-i" && has_value)
+			ok = parse_count(argv[++i], 1, max_iterations);
+		else if (arg == "-b" && has_value)
+		{
+			char* end;
+			budget = std::strtod(argv[++i], &end);
+			ok = *end == '\0' && budget > 0;
+		}
+		else if (arg == "-e" && has_value)
+		{
+			char* end;
+			tolerance = std::strtod(argv[++i], &end);
+			ok = *end == '\0' && tolerance > 0;
+		}
+		else if (arg == "-d" && has_value)
+			ok = parse_fraction(argv[++i], step);
+		else if (arg == "-l")
+			limited = true;
+		else if (arg == "-s" && has_value)
+			ok = parse_count(argv[++i], 0, seed);
+		else if (arg == "-p" && has_value)
+		{
+			ok = parse_list(argv[++i], solvers);
+			for (const auto& solver : solvers)
+			{
+				if (solver != "ccd" && solver != "fabrik" && solver != "dls")
+				{
+					std::cerr << "Unknown solver " << solver << std::endl;
+					return 1;
+				}
+			}
+		}
+		else if (arg == "-t" && has_value)
+			ok = parse_count(argv[++i], 0, threads);
+		else if (arg == "-o" && has_value)
+			output = argv[++i];
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [-n problems] [-k links] [-i iterations] [-b budget] [-e tolerance] [-d step] [-l] [-s seed] [-p solvers] [-t threads] [-o file.json]" << std::endl;
+			return 1;
+		}
+		if (!ok)
+		{
+			std::cerr << "Bad value for " << arg << ": " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+	if (solvers.empty())
+		solvers = { "ccd", "fabrik", "dls" };
+	const std::vector<Problem> problems = make_problems(n, links, seed);
+	igl::IKDriver driver;
+	driver.m_tolerance = tolerance;
+	driver.m_max_iterations = max_iterations;
+	driver.m_budget = budget;
+
+	std::ofstream out_file;
+	if (!output.empty())
+	{
+		out_file.open(output);
+		if (!out_file)
+		{
+			std::cerr << "Can't open " << output << std::endl;
+			return 1;
+		}
+	}
+	std::stringstream json;
+	json.precision(10);
+	json << "{\n  \"problems\": " << n
+		<< ",\n  \"links\": " << links
+		<< ",\n  \"max_iterations\": " << max_iterations
+		<< ",\n  \"budget_us\": ";
+	if (budget < std::numeric_limits<double>::infinity())
+		json << budget;
+	else
+		json << "null";
+	json
+		<< ",\n  \"tolerance\": " << tolerance
+		<< ",\n  \"step\": " << step
+		<< ",\n  \"limited\": " << (limited ? "true" : "false")
+		<< ",\n  \"seed\": " << seed
+		<< ",\n  \"threads\": ";
+	if (threads >= 0)
+		json << (threads > 0 ? threads : igl::WorkerPool(0).size());
+	else
+		json << "null";
+	json
+		<< ",\n  \"runs\": [";
+	for (size_t r = 0; r < solvers.size(); r++)
+	{
+		Result res = threads >= 0 ?
+			run_crowd(solvers[r], problems, driver, step, limited, threads) :
+			run(solvers[r], problems, driver, step, limited);
+		long long total_iterations = 0;
+		for (const int iterations : res.iterations)
+			total_iterations += iterations;
+		std::sort(res.iterations.begin(), res.iterations.end());
+		std::cerr << res.solver << ": " << res.solved << "/" << n << " solved, "
+			<< (double)total_iterations / n << " iterations and "
+			<< 1e6 * res.seconds / n << " us per problem" << std::endl;
+		json << (r ? "," : "") << "\n    {\n      \"solver\": \"" << res.solver << "\""
+			<< ",\n      \"solved\": " << res.solved
+			<< ",\n      \"over_budget\": " << res.over_budget
+			<< ",\n      \"iterations\": { \"total\": " << total_iterations
+			<< ", \"mean\": " << (double)total_iterations / n
+			<< ", \"median\": " << res.iterations[n / 2]
+			<< ", \"max\": " << res.iterations.back() << " }"
+			<< ",\n      \"mean_distance\": " << res.sum_distance / n
+			<< ",\n      \"seconds\": { \"total\": " << res.seconds
+			<< ", \"per_problem\": " << res.seconds / n
+			<< ", \"per_iteration\": " << (total_iterations ? res.seconds / total_iterations : 0.0) << " }"
+			<< "\n    }";
+	}
+	json << "\n  ]\n}\n";
+	(output.empty() ? std::cout : out_file) << json.str();
+	return 0;
+}
@@ -226,11 +226,21 @@ static void glfw_key_callback(GLFWwindow *window, int key, int scancode, int act
 			break;
 		case 'c':
 		case 'C':
-			scn->FABRIK = !scn->FABRIK;
-			if (scn->FABRIK)
+			switch (scn->solver)
+			{
+			case igl::IKCrowd::CCD:
+				scn->solver = igl::IKCrowd::FABRIK;
 				std::cout << "IK solver: FABRIK" << std::endl;
-			else
+				break;
+			case igl::IKCrowd::FABRIK:
+				scn->solver = igl::IKCrowd::DLS;
+				std::cout << "IK solver: damped least squares" << std::endl;
+				break;
+			case igl::IKCrowd::DLS:
+				scn->solver = igl::IKCrowd::CCD;
 				std::cout << "IK solver: CCD" << std::endl;
+				break;
+			}
 			break;
 		case 'b':
 		case 'B':
@@ -261,7 +271,7 @@ void sendBallToTip(SandBox *scn, int tip_idx)
 {
 	int ball_idx = scn->dest_idx;
 	scn->data_list[ball_idx].MyTranslate(-scn->data_list[ball_idx].GetTranslation(), true);
-	scn->data_list[ball_idx].MyTranslate((scn->CalcParentsTrans(tip_idx) * scn->data_list[tip_idx].MakeTransd() * Eigen::Vector4d(0, 0, -0.8, 1)).head(3), true);
+	scn->data_list[ball_idx].MyTranslate((scn->CalcWorldTrans(tip_idx) * Eigen::Vector4d(0, 0, -0.8, 1)).head(3), true);
 }
 
 void Init(Display &display, igl::opengl::glfw::imgui::ImGuiMenu *menu)
@@ -4,7 +4,6 @@
 #include "Eigen/dense"
 #include <functional>
 #include <igl/PI.h>
-double calcAngle(Eigen::Vector3d v1, Eigen::Vector3d v2);
 void AddAxes(igl::opengl::ViewerData &data, const Eigen::Vector3d &center);
 Eigen::Vector3d transform_vec3(Eigen::Matrix4d trans, Eigen::Vector3d vec3);
 
@@ -65,6 +64,17 @@ void SandBox::Init(const std::string &config)
 		nameFileout.close();
 	}
 	MyTranslate(Eigen::Vector3d(0, 0, -1), true);
+	UpdateTransforms();
+
+	if (!links.empty())
+		AddChain(first_link_idx, links.size(), dest_idx);
+
+	// Each frame iterates until the destination is reached, for at most a
+	// millisecond per chain
+	solver = igl::IKCrowd::FABRIK;
+	crowd.m_driver.m_max_iterations = 100;
+	crowd.m_driver.m_budget = 1000;
+	crowd.m_ccd.m_tolerance = crowd.m_driver.m_tolerance;
 
 	data().set_colors(Eigen::RowVector3d(0.9, 0.1, 0.1));
 	std::cout << "IK solver: FABRIK" << std::endl;
@@ -109,7 +119,7 @@ void SandBox::print_tip_positions()
 	Eigen::Vector3d tip;
 	for (int link : links)
 	{
-		tip = transform_vec3(CalcParentsTrans(link) * data_list[link].MakeTransd(), link_tip);
+		tip = transform_vec3(CalcWorldTrans(link), link_tip);
 		Eigen::IOFormat CleanFmt(4, 0, ", ", "\n", "(", ")");
 		std::cout << "Link " << link << " tip: " << tip.transpose().format(CleanFmt) << std::endl;
 	}
@@ -129,173 +139,61 @@ SandBox::~SandBox()
 void SandBox::Animate()
 {
 	if (isActive)
-	{
-		if (FABRIK)
-		{
-			FABRIK_iteration();
-		}
-		else
-		{
-
-			CCD_iteration();
-		}
-	}
+		SolveIK();
 }
 
-void SandBox::CCD_iteration()
+void SandBox::SolveIK()
 {
-	Eigen::Vector3d dest = data_list[dest_idx].GetTranslation();
-	Eigen::Vector3d base = (data_list[first_link_idx].MakeTransd() * Eigen::Vector4d(0, 0, 0.8, 1)).head(3);
-	Eigen::Vector3d last_tip, curr_tip, v1, v2, perp;
-	Eigen::Matrix3d curr_rot;
-	double angle;
-	int last_idx = data_list.size() - 1;
-	if ((base - dest).norm() > 1.6 * links.size())
-	{
-		std::cout << "cannot reach" << std::endl;
+	// Up to date, so that the threads only read the transforms
+	UpdateTransforms();
+	for (int c = 0; c < crowd.chains(); c++)
+		crowd.set_target(c, data_list[chain_targets[c]].GetTranslation());
+	crowd.m_ccd.m_limited = isLimited;
+	crowd.m_fabrik.m_limited = isLimited;
+	crowd.solve(solver, [this](int c, igl::IKChain &chain) { return LoadChain(c, chain); });
+	StoreChains();
+
+	if (crowd.chains() == 0)
 		return;
-	}
-	for (int i = last_idx; i >= first_link_idx; i--)
+	igl::IKChain &arm = crowd.chain(0);
+	const Eigen::Vector3d &t = crowd.target(0);
+	if (crowd.moved(0))
 	{
-		last_tip = (CalcParentsTrans(last_idx) * data_list[last_idx].MakeTransd() * Eigen::Vector4d(0, 0, -0.8, 1)).head(3);
-		curr_tip = (CalcParentsTrans(i) * Eigen::Vector4d(0, 0, -0.8, 1)).head(3);
-		if ((last_tip - dest).norm() < 0.1)
-		{
-			std::cout << "distance: " << (last_tip - dest).norm() << std::endl;
-			break;
-		}
-
-		v1 = last_tip - curr_tip;
-		v2 = dest - curr_tip;
-		
-		if (v2 == Eigen::Vector3d(0,0,0))
-			v2 = Eigen::Vector3d(0,0,0.01);
-		
-		perp = v1.cross(v2).normalized();
-
-		if (v1.normalized() == v2.normalized() || v1.normalized() == -v2.normalized())
-		{
-			if(v1.x() != 0 || v1.y() != 0)
-				perp = Eigen::Vector3d(v1.y(), -v1.x(), 0.);
-			else
-				perp = Eigen::Vector3d(1., 0, 0);
-		}
-
-		angle = calcAngle(v1, v2) / 10.0;
-
-		if (isLimited)
-		{
-			Eigen::Vector3d parent_z_axis = -((data_list[i].GetRotation() * Eigen::AngleAxisd(angle, perp).matrix()).transpose() * Eigen::Vector3d(0, 0, 1));
-			double alpha = calcAngle(parent_z_axis, Eigen::Vector3d(0, 0, 1));
-			if (alpha < (M_PI / 6))
-			{
-				angle = angle > 0.0 ? angle - ((M_PI / 6) - alpha) : angle + ((M_PI / 6) - alpha);
-			}
-		}
-
-		curr_rot = CalcParentsTrans(i).block<3, 3>(0, 0) * data_list[i].GetRotation();
-		data_list[i].MyRotate(curr_rot.transpose() * perp, angle);
+		const igl::IKDriver::Report &report = crowd.report(0);
+		if (report.stop == igl::IKDriver::CONVERGED)
+			std::cout << "reached in " << report.iterations << " iterations, " << report.microseconds << " us, distance: " << report.error << std::endl;
 	}
+	else if ((arm.base() - t).norm() > arm.reach())
+		std::cout << "cannot reach" << std::endl;
+	else
+		std::cout << "distance: " << (arm.end_effector() - t).norm() << std::endl;
 }
 
-void SandBox::FABRIK_iteration()
+int SandBox::AddChain(int first, int links, int target)
 {
-	Eigen::Vector3d t = data_list[dest_idx].GetTranslation();
-	double d = 1.6;
-	int n = links.size() + 1;
-	std::vector<Eigen::Matrix3d> rotations(n - 1);
-	std::vector<Eigen::Vector3d> p(n);
-	std::vector<Eigen::Vector3d> tips(n);
-	std::vector<double> r(n - 1);
-	std::vector<double> lam(n - 1);
-	Eigen::Vector3d b, v1, v2, perp;
-	double angle, dist;
-	for (int i = 0; i < n - 1; i++)
-	{
-		p[i] = (CalcParentsTrans(links[i]) * data_list[links[i]].MakeTransd() * Eigen::Vector4d(0, 0, 0.8, 1)).head(3);
-	}
-	p[n - 1] = (CalcParentsTrans(links[n - 2]) * data_list[links[n - 2]].MakeTransd() * Eigen::Vector4d(0, 0, -0.8, 1)).head(3);
-	tips = p;
-	dist = (p[0] - t).norm();
-	if (dist > 1.6 * (n - 1))
-	{
-		std::cout << "cannot reach" << std::endl;
-		return;
-	}
-	b = p[0];
-	if ((p[n - 1] - t).norm() < 0.1)
-	{
-		std::cout << "distance: " << (p[n - 1] - t).norm() << std::endl;
-		return;
-	}
-	// calculate the points
-	// forward
-	p[n - 1] = t;
-	for (int i = n - 2; i >= 0; i--)
-	{
-		r[i] = (p[i + 1] - p[i]).norm();
-		lam[i] = d / r[i];
-		p[i] = (1 - lam[i]) * p[i + 1] + lam[i] * p[i];
-		if (isLimited && i != n - 2)
-		{
-			Eigen::Vector3d next_joint = p[i + 2] - p[i + 1];
-			Eigen::Vector3d curr_joint = p[i] - p[i + 1];
-			double alpha = calcAngle(next_joint, curr_joint);
-			if (alpha < (M_PI / 6))
-			{
-				if (next_joint == Eigen::Vector3d(0,0,0))
-					next_joint = Eigen::Vector3d(0,0,0.01);
-				perp = next_joint.cross(curr_joint);
-				if (curr_joint.normalized() == next_joint.normalized() || curr_joint.normalized() == -next_joint.normalized())
-				{
-					if(curr_joint.x() != 0 || curr_joint.y() != 0)
-						perp = Eigen::Vector3d(curr_joint.y(), -curr_joint.x(), 0.);
-					else
-						perp = Eigen::Vector3d(1., 0, 0);
-				}
-				p[i] = p[i + 1] + Eigen::AngleAxisd(M_PI / 6, perp.normalized()) * next_joint;
-			}
-		}
-	}
-	// backward
-	p[0] = b;
-	for (int i = 0; i < n - 1; i++)
-	{
-		r[i] = (p[i + 1] - p[i]).norm();
-		lam[i] = d / r[i];
-		p[i + 1] = (1 - lam[i]) * p[i] + lam[i] * p[i + 1];
-	}
-
-	// apply the rotations
-	Eigen::Matrix3d curr_rot = Eigen::Matrix3d::Identity();
-	for (int i = 0; i < n - 1; i++)
-	{
-		v1 = tips[i + 1] - tips[i];
-		v2 = p[i + 1] - tips[i];
-
-		if (v2 == Eigen::Vector3d(0,0,0))
-			v2 = Eigen::Vector3d(0,0,0.01);
-
-		perp = v1.cross(v2).normalized();
-
-		if (v1.normalized() == v2.normalized() || v1.normalized() == -v2.normalized())
-		{
-			if(v1.x() != 0 || v1.y() != 0)
-				perp = Eigen::Vector3d(v1.y(), -v1.x(), 0.);
-			else
-				perp = Eigen::Vector3d(1., 0, 0);
-		}
-
-		angle = calcAngle(v1, v2) / 10.0;
-		curr_rot = CalcParentsTrans(links[i]).block<3, 3>(0, 0) * data_list[links[i]].GetRotation();
+	chain_targets.push_back(target);
+	return crowd.add_chain(first, links);
+}
 
-		data_list[links[i]].MyRotate(curr_rot.transpose() * perp, angle);
+bool SandBox::LoadChain(int c, igl::IKChain &chain)
+{
+	const int first = crowd.first(c);
+	for (int i = 0; i < chain.links(); i++)
+		chain.set_link(i, CalcWorldTrans(first + i), Eigen::Vector3d(0, 0, 0.8), link_tip);
+	const Eigen::Vector3d &t = crowd.target(c);
+	return (chain.base() - t).norm() <= chain.reach() && (chain.end_effector() - t).norm() >= crowd.m_driver.m_tolerance;
+}
 
-		for (int j = 0; j < n - 1; j++)
-		{
-			tips[j] = transform_vec3(CalcParentsTrans(links[j]) * data_list[links[j]].MakeTransd(), Eigen::Vector3d(0, 0, 0.8));
-		}
-		tips[n - 1] = transform_vec3(CalcParentsTrans(links[n - 2]) * data_list[links[n - 2]].MakeTransd(), Eigen::Vector3d(0, 0, -0.8));
+void SandBox::StoreChains()
+{
+	// One at a time, moving an object marks the scene graph
+	for (int c = 0; c < crowd.chains(); c++)
+	{
+		if (!crowd.moved(c))
+			continue;
+		igl::IKChain &chain = crowd.chain(c);
+		for (int i = 0; i < chain.links(); i++)
+			data_list[crowd.first(c) + i].MyRotate(chain.m_rotations[i]);
 	}
 }
 
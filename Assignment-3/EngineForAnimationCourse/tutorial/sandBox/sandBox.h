@@ -1,6 +1,7 @@
 #pragma once
 #include "igl/opengl/glfw/Viewer.h"
 #include "igl/aabb.h"
+#include "igl/IKCrowd.h"
 
 class SandBox : public igl::opengl::glfw::Viewer
 {
@@ -9,16 +10,31 @@ public:
 	void print_transformations();
 	void print_tip_positions();
 	void print_destination();
-	void CCD_iteration();
-	void FABRIK_iteration();
+	// Turn the links of every chain towards its destination with the
+	// current solver, within the time budget of crowd.m_driver per chain
+	void SolveIK();
+	// Register the links first to first + links - 1, each hanging from
+	// the one before, as a chain turning towards data_list[target].
+	// Returns the index of the chain in crowd.
+	int AddChain(int first, int links, int target);
 	~SandBox();
 	void Init(const std::string& config);
 	double doubleVariable;
-	bool FABRIK;
+	igl::IKCrowd::Method solver;
+	// The chains, the arm of the config file first
+	igl::IKCrowd crowd;
 private:
 	// Prepare array-based edge data structures and priority queue
 	
 	
 	void Animate();
+	// Copy the links of chain c, false if its end effector is at its
+	// target or cannot get there; only reads the scene. And the rotations
+	// of the chains back to the links.
+	bool LoadChain(int c, igl::IKChain &chain);
+	void StoreChains();
+
+	// Per chain, index of the destination in data_list
+	std::vector<int> chain_targets;
 };
 